@@ -0,0 +1,734 @@
+#include <string>
+#include <vector>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include "compiler.hpp"
+#include "interpreter.hpp"
+#include "node.hpp"
+
+using namespace std;
+
+ostream &operator<<(ostream &os, const OP_CODE &op)
+{
+    switch (op)
+    {
+        case OpPushVoid:
+            return os << "PushVoid";
+        case OpPop:
+            return os << "Pop";
+        case OpConstant:
+            return os << "Constant";
+        case OpType:
+            return os << "Type";
+        case OpFunction:
+            return os << "Function";
+        case OpGetVariable:
+            return os << "GetVariable";
+        case OpDeclareVariable:
+            return os << "DeclareVariable";
+        case OpBinary:
+            return os << "Binary";
+        case OpUnary:
+            return os << "Unary";
+        case OpAssign:
+            return os << "Assign";
+        case OpGetFunction:
+            return os << "GetFunction";
+        case OpCall:
+            return os << "Call";
+        case OpTailCall:
+            return os << "TailCall";
+        case OpClass:
+            return os << "Class";
+        case OpGetClass:
+            return os << "GetClass";
+        case OpNew:
+            return os << "New";
+        case OpGetMember:
+            return os << "GetMember";
+        case OpMemberEnter:
+            return os << "MemberEnter";
+        case OpMemberExit:
+            return os << "MemberExit";
+        case OpScopeEnter:
+            return os << "ScopeEnter";
+        case OpScopeExit:
+            return os << "ScopeExit";
+        case OpJump:
+            return os << "Jump";
+        case OpJumpIfFalse:
+            return os << "JumpIfFalse";
+        case OpCaseCompare:
+            return os << "CaseCompare";
+        case OpCaseTest:
+            return os << "CaseTest";
+        case OpReturn:
+            return os << "Return";
+    }
+
+    return os;
+}
+
+Instruction::Instruction(OP_CODE op, int node, int operand, int slot) : op(op), node(node), operand(operand), slot(slot)
+{
+
+}
+
+ostream &operator<<(ostream &os, const Instruction &instruction)
+{
+    return os << instruction.op << " " << instruction.node << " " << instruction.operand << " " << instruction.slot;
+}
+
+Chunk::Chunk() : slot_count(0)
+{
+
+}
+
+int Chunk::Emit(OP_CODE op, Node *node, int operand, int slot)
+{
+    int node_index = -1;
+
+    if (node != NULL)
+    {
+        node_index = nodes.size();
+
+        nodes.push_back(node);
+    }
+
+    code.push_back(Instruction(op, node_index, operand, slot));
+
+    return code.size() - 1;
+}
+
+int Chunk::AddConstant(Value value)
+{
+    constants.push_back(value);
+
+    return constants.size() - 1;
+}
+
+void Chunk::Patch(int position, int target)
+{
+    code[position].operand = target;
+}
+
+ostream &operator<<(ostream &os, const Chunk &chunk)
+{
+    for (int i = 0; i < chunk.code.size(); i++)
+    {
+        os << i << ": " << chunk.code[i] << "\n";
+    }
+
+    for (int i = 0; i < chunk.chunks.size(); i++)
+    {
+        os << "\nChunk " << i << ":\n" << *chunk.chunks[i];
+    }
+
+    return os;
+}
+
+Scope::Scope(bool resolvable) : resolvable(resolvable), slot_count(0)
+{
+
+}
+
+int Scope::Declare(string name)
+{
+    auto existing = names.find(name);
+
+    if (existing != names.end())
+    {
+        return existing->second;
+    }
+
+    names.insert({name, slot_count});
+
+    return slot_count++;
+}
+
+Address::Address(int depth, int slot) : depth(depth), slot(slot)
+{
+
+}
+
+LoopTarget::LoopTarget(int scope_depth, int pending_values) : scope_depth(scope_depth), pending_values(pending_values), continue_target(-1)
+{
+
+}
+
+Compiler::Compiler(bool resolvable) : chunk(shared_ptr<Chunk>(new Chunk())), pending_values(0), scopes({ Scope(resolvable) })
+{
+
+}
+
+Address Compiler::Resolve(string name)
+{
+    for (int i = scopes.size() - 1; i >= 0; i--)
+    {
+        if (!scopes[i].resolvable)
+        {
+            break;
+        }
+
+        auto slot = scopes[i].names.find(name);
+
+        if (slot != scopes[i].names.end())
+        {
+            return Address(scopes.size() - 1 - i, slot->second);
+        }
+    }
+
+    return Address(0, -1);
+}
+
+void Compiler::BeginScope(bool resolvable)
+{
+    scopes.push_back(Scope(resolvable));
+}
+
+int Compiler::EndScope()
+{
+    int slot_count = scopes.back().slot_count;
+
+    scopes.pop_back();
+
+    return slot_count;
+}
+
+void Compiler::EndBlockScope(int scope_enter)
+{
+    // The environments of the block are sized from its slots and share the names of the scope
+    chunk->code[scope_enter].slot = chunk->scope_names.size();
+    chunk->scope_names.push_back(make_shared<const SlotNames>(scopes.back().names));
+
+    chunk->Patch(scope_enter, EndScope());
+}
+
+void Compiler::CompileStatements(vector<Node*> statements, bool keep_last)
+{
+    for (int i = 0; i < statements.size(); i++)
+    {
+        CompileNode(statements[i]);
+
+        if (!keep_last || i < statements.size() - 1)
+        {
+            chunk->Emit(OpPop);
+        }
+    }
+
+    if (keep_last && statements.size() == 0)
+    {
+        chunk->Emit(OpPushVoid);
+    }
+}
+
+void Compiler::CompileOperation(Operation *operation)
+{
+    // Chains of operators are compiled on an explicit stack, so their length only costs heap memory.
+    // Each pending operation is visited once to queue its operands and again to emit its operator.
+    vector<pair<Node*, bool>> pending = { {operation, false} };
+
+    while (pending.size() != 0)
+    {
+        pair<Node*, bool> current = pending.back();
+        pending.pop_back();
+
+        Node *node = get<0>(current);
+
+        if (node == NULL || node->kind != OperationNode)
+        {
+            CompileNode(node);
+
+            continue;
+        }
+
+        Operation *current_operation = (Operation*)node;
+
+        if (!get<1>(current))
+        {
+            // The left operand is queued last so it is compiled first
+            pending.push_back({current_operation, true});
+            pending.push_back({current_operation->right, false});
+
+            if (current_operation->left != NULL)
+            {
+                pending.push_back({current_operation->left, false});
+            }
+
+            continue;
+        }
+
+        if (current_operation->left != NULL)
+        {
+            chunk->Emit(OpBinary, node);
+
+            if (IsAssignment(current_operation->operator_code))
+            {
+                Address address = current_operation->left->kind == GetVariableNode ? Resolve(((GetVariable*)current_operation->left)->name) : Address(0, -1);
+
+                chunk->Emit(OpAssign, current_operation->left, address.depth, address.slot);
+            }
+        }
+        else
+        {
+            chunk->Emit(OpUnary, node);
+        }
+    }
+}
+
+void Compiler::CompileNode(Node *node)
+{
+    if (node == NULL)
+    {
+        chunk->Emit(OpPushVoid);
+
+        return;
+    }
+
+    if (StackExhausted())
+    {
+        throw ErrorObject(node->start, node->end, Error {RecursionError, "Maximum nesting depth exceeded"});
+    }
+
+    switch (node->kind)
+    {
+        case TypeExpressionNode:
+        {
+            chunk->Emit(OpType, node);
+
+            break;
+        }
+        case LiteralNode:
+        {
+            chunk->Emit(OpConstant, NULL, chunk->AddConstant(InterpretLiteral((Literal*)node)));
+
+            break;
+        }
+        case CodeBlockNode:
+        {
+            chunk->chunks.push_back(CompileFunction((CodeBlock*)node));
+
+            chunk->Emit(OpFunction, node, chunk->chunks.size() - 1);
+
+            break;
+        }
+        case OperationNode:
+        {
+            CompileOperation((Operation*)node);
+
+            break;
+        }
+        case GetVariableNode:
+        {
+            Address address = Resolve(((GetVariable*)node)->name);
+
+            chunk->Emit(OpGetVariable, node, address.depth, address.slot);
+
+            break;
+        }
+        case DeclareVariableNode:
+        {
+            DeclareVariable *declare_variable = (DeclareVariable*)node;
+
+            // The value is compiled first so that it cannot refer to the variable being declared
+            CompileNode(declare_variable->value);
+
+            int slot = scopes.back().resolvable ? scopes.back().Declare(declare_variable->name) : -1;
+
+            chunk->Emit(OpDeclareVariable, node, 0, slot);
+
+            break;
+        }
+        case FunctionCallNode:
+        {
+            CompileFunctionCall((FunctionCall*)node, OpCall);
+
+            break;
+        }
+        case ClassDefinitionNode:
+        {
+            chunk->chunks.push_back(CompileClass((ClassDefinition*)node));
+
+            chunk->Emit(OpClass, node, chunk->chunks.size() - 1);
+
+            break;
+        }
+        case InstanceClassNode:
+        {
+            InstanceClass *instance_class = (InstanceClass*)node;
+
+            chunk->Emit(OpGetClass, node);
+
+            for (Node *argument : instance_class->arguments)
+            {
+                CompileNode(argument);
+            }
+
+            chunk->Emit(OpNew, node, instance_class->arguments.size());
+
+            break;
+        }
+        case MemberAccessNode:
+        {
+            // The object is resolved like any other identifier, only the member is looked up by name
+            Address address = Resolve(((MemberAccess*)node)->name);
+
+            if (((MemberAccess*)node)->statement->kind == GetVariableNode)
+            {
+                chunk->Emit(OpGetMember, node, address.depth, address.slot);
+
+                break;
+            }
+
+            chunk->Emit(OpMemberEnter, node, address.depth, address.slot);
+            BeginScope(false);
+
+            CompileNode(((MemberAccess*)node)->statement);
+
+            EndScope();
+            chunk->Emit(OpMemberExit);
+
+            break;
+        }
+        case IfStatementNode:
+        {
+            IfStatement *if_statement = (IfStatement*)node;
+
+            vector<Node*> expressions = { if_statement->if_expression };
+            vector<CodeBlock*> code_blocks = { if_statement->if_code_block };
+
+            expressions.insert(expressions.end(), if_statement->else_if_expressions.begin(), if_statement->else_if_expressions.end());
+            code_blocks.insert(code_blocks.end(), if_statement->else_if_code_blocks.begin(), if_statement->else_if_code_blocks.end());
+
+            vector<int> end_jumps = {};
+
+            for (int i = 0; i < expressions.size(); i++)
+            {
+                CompileNode(expressions[i]);
+
+                int next_jump = chunk->Emit(OpJumpIfFalse, expressions[i]);
+
+                CompileStatements(code_blocks[i]->content, false);
+
+                end_jumps.push_back(chunk->Emit(OpJump));
+
+                chunk->Patch(next_jump, chunk->code.size());
+            }
+
+            if (if_statement->else_code_block != NULL)
+            {
+                CompileStatements(if_statement->else_code_block->content, false);
+            }
+
+            for (int jump : end_jumps)
+            {
+                chunk->Patch(jump, chunk->code.size());
+            }
+
+            chunk->Emit(OpPushVoid);
+
+            break;
+        }
+        case SwitchStatementNode:
+        {
+            SwitchStatement *switch_statement = (SwitchStatement*)node;
+
+            CompileNode(switch_statement->switch_expression);
+
+            // The switch value stays on the stack until a case matches
+            pending_values++;
+
+            vector<int> end_jumps = {};
+
+            for (int i = 0; i < switch_statement->case_expressions.size(); i++)
+            {
+                CompileNode(switch_statement->case_expressions[i]);
+
+                chunk->Emit(OpCaseCompare, switch_statement->case_expressions[i]);
+
+                int next_jump = chunk->Emit(OpCaseTest, switch_statement->case_expressions[i]);
+
+                chunk->Emit(OpPop);
+                pending_values--;
+
+                CompileStatements(switch_statement->case_code_blocks[i]->content, false);
+
+                pending_values++;
+
+                end_jumps.push_back(chunk->Emit(OpJump));
+
+                chunk->Patch(next_jump, chunk->code.size());
+            }
+
+            chunk->Emit(OpPop);
+            pending_values--;
+
+            if (switch_statement->default_code_block != NULL)
+            {
+                CompileStatements(switch_statement->default_code_block->content, false);
+            }
+
+            for (int jump : end_jumps)
+            {
+                chunk->Patch(jump, chunk->code.size());
+            }
+
+            chunk->Emit(OpPushVoid);
+
+            break;
+        }
+        case ForLoopNode:
+        {
+            ForLoop *for_loop = (ForLoop*)node;
+
+            int for_scope = chunk->Emit(OpScopeEnter);
+            BeginScope(true);
+
+            if (for_loop->declaration_expression != NULL)
+            {
+                CompileNode(for_loop->declaration_expression);
+
+                chunk->Emit(OpPop);
+            }
+
+            loops.push_back(LoopTarget(scopes.size(), pending_values));
+
+            int condition = chunk->code.size();
+            int end_jump = -1;
+
+            if (for_loop->condition_expression != NULL)
+            {
+                CompileNode(for_loop->condition_expression);
+
+                end_jump = chunk->Emit(OpJumpIfFalse, for_loop->condition_expression);
+            }
+
+            CompileLoopBody(for_loop->for_code_block);
+
+            loops.back().continue_target = chunk->code.size();
+
+            if (for_loop->iteration_expression != NULL)
+            {
+                CompileNode(for_loop->iteration_expression);
+
+                chunk->Emit(OpPop);
+            }
+
+            chunk->Emit(OpJump, NULL, condition);
+
+            if (end_jump != -1)
+            {
+                chunk->Patch(end_jump, chunk->code.size());
+            }
+
+            for (int jump : loops.back().breaks)
+            {
+                chunk->Patch(jump, chunk->code.size());
+            }
+
+            for (int jump : loops.back().continues)
+            {
+                chunk->Patch(jump, loops.back().continue_target);
+            }
+
+            loops.pop_back();
+
+            EndBlockScope(for_scope);
+            chunk->Emit(OpScopeExit, NULL, 1);
+
+            chunk->Emit(OpPushVoid);
+
+            break;
+        }
+        case WhileLoopNode:
+        {
+            WhileLoop *while_loop = (WhileLoop*)node;
+
+            loops.push_back(LoopTarget(scopes.size(), pending_values));
+
+            int condition = chunk->code.size();
+
+            loops.back().continue_target = condition;
+
+            CompileNode(while_loop->condition);
+
+            int end_jump = chunk->Emit(OpJumpIfFalse, while_loop->condition);
+
+            CompileLoopBody(while_loop->while_code_block);
+
+            chunk->Emit(OpJump, NULL, condition);
+
+            chunk->Patch(end_jump, chunk->code.size());
+
+            for (int jump : loops.back().breaks)
+            {
+                chunk->Patch(jump, chunk->code.size());
+            }
+
+            for (int jump : loops.back().continues)
+            {
+                chunk->Patch(jump, loops.back().continue_target);
+            }
+
+            loops.pop_back();
+
+            chunk->Emit(OpPushVoid);
+
+            break;
+        }
+        case ReturnNode:
+        {
+            Return *return_node = (Return*)node;
+
+            if (return_node->tail_call)
+            {
+                CompileFunctionCall((FunctionCall*)return_node->expression, OpTailCall);
+            }
+            else
+            {
+                CompileNode(return_node->expression);
+            }
+
+            chunk->Emit(OpReturn);
+
+            break;
+        }
+        case BreakNode:
+        case ContinueNode:
+        {
+            CompileLoopExit(node);
+
+            break;
+        }
+        default:
+        {
+            // TODO: ForEachLoop is only possible when iterative types exist
+            chunk->Emit(OpPushVoid);
+
+            break;
+        }
+    }
+}
+
+void Compiler::CompileFunctionCall(FunctionCall *function_call, OP_CODE op)
+{
+    Address address = Resolve(function_call->name);
+
+    chunk->Emit(OpGetFunction, function_call, address.depth, address.slot);
+
+    for (Node *argument : function_call->arguments)
+    {
+        CompileNode(argument);
+    }
+
+    chunk->Emit(op, function_call, function_call->arguments.size());
+}
+
+void Compiler::CompileLoopBody(CodeBlock *code_block)
+{
+    // A body that declares nothing has no scope, so an iteration does not allocate an environment
+    if (!code_block->declares)
+    {
+        CompileStatements(code_block->content, false);
+
+        return;
+    }
+
+    int body_scope = chunk->Emit(OpScopeEnter);
+    BeginScope(true);
+
+    CompileStatements(code_block->content, false);
+
+    EndBlockScope(body_scope);
+    chunk->Emit(OpScopeExit, NULL, 1);
+}
+
+void Compiler::CompileLoopExit(Node *node)
+{
+    // Outside of a loop break and continue end the enclosing function like the tree-walking interpreter
+    if (loops.size() == 0)
+    {
+        chunk->Emit(OpPushVoid);
+        chunk->Emit(OpReturn);
+
+        return;
+    }
+
+    for (int i = loops.back().pending_values; i < pending_values; i++)
+    {
+        chunk->Emit(OpPop);
+    }
+
+    if (scopes.size() > loops.back().scope_depth)
+    {
+        chunk->Emit(OpScopeExit, NULL, scopes.size() - loops.back().scope_depth);
+    }
+
+    if (node->kind == BreakNode)
+    {
+        loops.back().breaks.push_back(chunk->Emit(OpJump));
+    }
+    else
+    {
+        loops.back().continues.push_back(chunk->Emit(OpJump));
+    }
+
+    // Keeps the statement list balanced, the value is never reached
+    chunk->Emit(OpPushVoid);
+}
+
+shared_ptr<Chunk> Compile(vector<Node*> AST)
+{
+    Compiler compiler = Compiler(false);
+
+    compiler.CompileStatements(AST, true);
+
+    compiler.chunk->Emit(OpReturn);
+
+    return compiler.chunk;
+}
+
+shared_ptr<Chunk> CompileExpression(Node *expression)
+{
+    Compiler compiler = Compiler(false);
+
+    compiler.CompileNode(expression);
+
+    compiler.chunk->Emit(OpReturn);
+
+    return compiler.chunk;
+}
+
+shared_ptr<Chunk> CompileFunction(CodeBlock *code_block)
+{
+    Compiler compiler = Compiler(true);
+
+    // Arguments are placed in the first slots of the function environment
+    for (ParameterExpression parameter : code_block->parameters)
+    {
+        compiler.scopes.back().Declare(parameter.name);
+    }
+
+    compiler.CompileStatements(code_block->content, true);
+
+    compiler.chunk->Emit(OpReturn);
+    compiler.chunk->slot_count = compiler.scopes.back().slot_count;
+    compiler.chunk->slot_names = make_shared<const SlotNames>(compiler.scopes.back().names);
+
+    return compiler.chunk;
+}
+
+shared_ptr<Chunk> CompileClass(ClassDefinition *class_definition)
+{
+    Compiler compiler = Compiler(true);
+
+    compiler.CompileStatements(class_definition->body, true);
+
+    compiler.chunk->Emit(OpReturn);
+    compiler.chunk->slot_count = compiler.scopes.back().slot_count;
+    compiler.chunk->slot_names = make_shared<const SlotNames>(compiler.scopes.back().names);
+
+    return compiler.chunk;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef compiler_hpp
+#define compiler_hpp
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include "node.hpp"
+#include "object.hpp"
+
+enum OP_CODE
+{
+    OpPushVoid,
+    OpPop,
+    OpConstant,
+    OpType,
+    OpFunction,
+    OpGetVariable,
+    OpDeclareVariable,
+    OpBinary,
+    OpUnary,
+    OpAssign,
+    OpGetFunction,
+    OpCall,
+    OpTailCall,
+    OpClass,
+    OpGetClass,
+    OpNew,
+    OpGetMember,
+    OpMemberEnter,
+    OpMemberExit,
+    OpScopeEnter,
+    OpScopeExit,
+    OpJump,
+    OpJumpIfFalse,
+    OpCaseCompare,
+    OpCaseTest,
+    OpReturn,
+};
+
+std::ostream &operator<<(std::ostream &os, const OP_CODE &op);
+
+class Instruction
+{
+    public:
+        OP_CODE op;
+        int node;
+        // For variable instructions the operand is the resolved scope depth
+        int operand;
+        int slot;
+
+        Instruction(OP_CODE op, int node, int operand, int slot);
+
+        friend std::ostream &operator<<(std::ostream &os, const Instruction &instruction);
+};
+
+class Chunk
+{
+    public:
+        std::vector<Instruction> code;
+        std::vector<Node*> nodes;
+        // Literals are materialised once when the chunk is compiled and shared by every execution
+        std::vector<Value> constants;
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        int slot_count;
+        // Names of the slots of function and class chunks, and of each block scope the chunk enters
+        std::shared_ptr<const SlotNames> slot_names;
+        std::vector<std::shared_ptr<const SlotNames>> scope_names;
+
+        Chunk();
+
+        int Emit(OP_CODE op, Node *node = NULL, int operand = 0, int slot = -1);
+
+        int AddConstant(Value value);
+
+        void Patch(int position, int target);
+
+        friend std::ostream &operator<<(std::ostream &os, const Chunk &chunk);
+};
+
+class Scope
+{
+    public:
+        // Scopes whose variables are only known at runtime (the environment passed into a script,
+        // member access) stop resolution and fall back to name lookup
+        bool resolvable;
+        std::map<std::string, int> names;
+        int slot_count;
+
+        Scope(bool resolvable);
+
+        int Declare(std::string name);
+};
+
+class Address
+{
+    public:
+        int depth;
+        int slot;
+
+        Address(int depth, int slot);
+};
+
+class LoopTarget
+{
+    public:
+        int scope_depth;
+        int pending_values;
+        int continue_target;
+        std::vector<int> breaks;
+        std::vector<int> continues;
+
+        LoopTarget(int scope_depth, int pending_values);
+};
+
+class Compiler
+{
+    public:
+        std::shared_ptr<Chunk> chunk;
+        int pending_values;
+        std::vector<LoopTarget> loops;
+        std::vector<Scope> scopes;
+
+        Compiler(bool resolvable);
+
+        Address Resolve(std::string name);
+
+        void BeginScope(bool resolvable);
+
+        int EndScope();
+
+        void EndBlockScope(int scope_enter);
+
+        void CompileStatements(std::vector<Node*> statements, bool keep_last);
+
+        void CompileNode(Node *node);
+
+        void CompileOperation(Operation *operation);
+
+        void CompileFunctionCall(FunctionCall *function_call, OP_CODE op);
+
+        void CompileLoopBody(CodeBlock *code_block);
+
+        void CompileLoopExit(Node *node);
+};
+
+std::shared_ptr<Chunk> Compile(std::vector<Node*> AST);
+
+std::shared_ptr<Chunk> CompileExpression(Node *expression);
+
+std::shared_ptr<Chunk> CompileFunction(CodeBlock *code_block);
+
+std::shared_ptr<Chunk> CompileClass(ClassDefinition *class_definition);
+
+#endif
\ No newline at end of file
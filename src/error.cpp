@@ -3,11 +3,28 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <exception>
+#include <pthread.h>
 
 #include "error.hpp"
 
 using namespace std;
 
+// Left free at the end of the stack for the largest frames between two checks
+constexpr uintptr_t Native_Stack_Reserve = 512 * 1024;
+
+// Every level of interpreted calls may take this much native stack, the rest is the usual 8 MiB for nesting
+constexpr size_t Native_Call_Size = 24 * 1024;
+constexpr size_t Native_Stack_Size = 8 * 1024 * 1024;
+
+// Larger depths are not reserved up front, deep recursion beyond this ends at the nesting limit instead
+constexpr size_t Max_Native_Stack_Size = 256 * 1024 * 1024;
+
+static thread_local uintptr_t Stack_Limit = 0;
+
 ostream &operator<<(ostream &os, const ERROR_TYPE &e)
 {
     switch (e)
@@ -24,12 +41,14 @@ ostream &operator<<(ostream &os, const ERROR_TYPE &e)
             return os << "OperationError";
         case ClassError:
             return os << "ClassError";
+        case RecursionError:
+            return os << "RecursionError";
     }
 
     return os;
 }
 
-int ThrowError(Error error, int start, int end, vector<int> line_numbers, vector<string> lines)
+int ThrowError(Error error, int start, int end, vector<int> line_numbers, vector<string> lines, vector<TraceFrame> stack_trace)
 {
     pair<pair<int, int>, pair<int, int>> positions = GetPositions(line_numbers, start, end);
 
@@ -80,11 +99,158 @@ int ThrowError(Error error, int start, int end, vector<int> line_numbers, vector
 
     cout << "\n";
 
+    for (string frame : FormatStackTrace(stack_trace, line_numbers))
+    {
+        cout << "\033[0;31m  " << frame << "\033[m\n";
+    }
+
+    if (stack_trace.size() != 0)
+    {
+        cout << "\n";
+    }
+
     cout << "\033[30mCompilation Terminated.\033[m\n";
 
     return 1;
 }
 
+vector<string> FormatStackTrace(const vector<TraceFrame> &stack_trace, const vector<int> &line_numbers)
+{
+    vector<string> frames = vector<string>();
+
+    string previous;
+    int repeats = 0;
+
+    for (const TraceFrame &frame : stack_trace)
+    {
+        string text = "in " + frame.name + " called at line " + to_string(GetPositions(line_numbers, frame.start, frame.end).first.first);
+
+        // Runs of the same frame, as left by deep recursion, are shown once with a count
+        if (frames.size() != 0 && text == previous)
+        {
+            repeats++;
+
+            continue;
+        }
+
+        if (repeats != 0)
+        {
+            frames.push_back("... previous frame repeated " + to_string(repeats) + " more times");
+        }
+
+        frames.push_back(text);
+
+        previous = text;
+        repeats = 0;
+    }
+
+    if (repeats != 0)
+    {
+        frames.push_back("... previous frame repeated " + to_string(repeats) + " more times");
+    }
+
+    return frames;
+}
+
+bool StackExhausted()
+{
+    // The bounds of the stack are looked up once for each thread, so the check holds on any stack size
+    if (Stack_Limit == 0)
+    {
+        uintptr_t stack_address = 0;
+
+#ifdef __GLIBC__
+        pthread_attr_t attributes;
+
+        void *address = NULL;
+        size_t stack_size = 0;
+
+        if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+        {
+            pthread_attr_getstack(&attributes, &address, &stack_size);
+            pthread_attr_destroy(&attributes);
+
+            stack_address = (uintptr_t)address;
+        }
+#endif
+
+        // Elsewhere the usual 8 MiB below the first check is assumed
+        if (stack_address == 0)
+        {
+            stack_address = (uintptr_t)__builtin_frame_address(0) - Native_Stack_Size;
+        }
+
+        Stack_Limit = stack_address + Native_Stack_Reserve;
+    }
+
+    return (uintptr_t)__builtin_frame_address(0) < Stack_Limit;
+}
+
+struct StackTask
+{
+public:
+    const function<int()> *body;
+    size_t stack_size;
+    int result;
+    exception_ptr exception;
+
+};
+
+static void *RunStackTask(void *data)
+{
+    StackTask *task = (StackTask*)data;
+
+#ifndef __GLIBC__
+    // The size of this stack is known, so its bounds need no lookup
+    Stack_Limit = (uintptr_t)__builtin_frame_address(0) - task->stack_size + Native_Stack_Reserve;
+#endif
+
+    try
+    {
+        task->result = (*task->body)();
+    }
+    catch (...)
+    {
+        task->exception = current_exception();
+    }
+
+    return NULL;
+}
+
+int RunWithCallStack(int call_depth, const function<int()> &body)
+{
+    size_t stack_size = min(Native_Stack_Size + (size_t)call_depth * Native_Call_Size, Max_Native_Stack_Size);
+
+    StackTask task = {&body, stack_size, 0, NULL};
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, stack_size);
+
+    pthread_t thread;
+
+    if (pthread_create(&thread, &attributes, RunStackTask, &task) != 0)
+    {
+        pthread_attr_destroy(&attributes);
+
+        cout << "\033[1;31mError:\033[0;31m Could not reserve " << stack_size / (1024 * 1024) << " MiB of stack for a call depth of " << call_depth << ", lower it with --max-depth\033[m\n";
+
+        cout << "\033[30mCompilation Terminated.\033[m\n";
+
+        return 1;
+    }
+
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attributes);
+
+    if (task.exception)
+    {
+        rethrow_exception(task.exception);
+    }
+
+    return task.result;
+}
+
 pair<pair<int, int>, pair<int, int>> GetPositions(vector<int> lines, int start, int end)
 {
     lines.insert(lines.begin(), 0);
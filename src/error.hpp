@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 
 enum ERROR_TYPE
 {
@@ -12,6 +13,7 @@ enum ERROR_TYPE
     FunctionError,
     OperationError,
     ClassError,
+    RecursionError,
 };
 
 std::ostream &operator<<(std::ostream &os, const ERROR_TYPE &e);
@@ -24,7 +26,26 @@ public:
 
 };
 
-int ThrowError(Error error, int start, int end, std::vector<int> line_numbers, std::vector<std::string> lines);
+struct TraceFrame
+{
+public:
+    std::string name;
+    int start;
+    int end;
+
+};
+
+int ThrowError(Error error, int start, int end, std::vector<int> line_numbers, std::vector<std::string> lines, std::vector<TraceFrame> stack_trace = {});
+
+// One line per frame of a stack trace, innermost first, with runs of identical frames collapsed into a count
+std::vector<std::string> FormatStackTrace(const std::vector<TraceFrame> &stack_trace, const std::vector<int> &line_numbers);
+
+// Recursive passes check this before descending, so deep programs end with an error instead of overflowing the native stack
+bool StackExhausted();
+
+// Runs body on a thread with enough native stack for call_depth nested calls of the tree-walking interpreter, rethrowing what it throws.
+// The stack is capped at 256 MiB, and if the thread cannot be created the error is printed and 1 returned.
+int RunWithCallStack(int call_depth, const std::function<int()> &body);
 
 std::pair<std::pair<int, int>, std::pair<int, int>> GetPositions(std::vector<int> lines, int start, int end);
 
@@ -11,230 +11,133 @@
 
 using namespace std;
 
-pair<shared_ptr<Object>, RETURN_REASON> Interpret(vector<Node*> AST, shared_ptr<Environment> env, vector<Call> call_stack)
+// Operations nested deeper than this are evaluated on explicit stacks instead of recursing
+const int Operation_Recursion_Limit = 32;
+
+pair<Value, RETURN_REASON> Interpret(const vector<Node*> &AST, const shared_ptr<Environment> &env, Call *call_stack)
 {
-    shared_ptr<Object> return_value = shared_ptr<Object>(new VoidObject());
+    Value return_value = Value();
 
-    for (Node* node : AST)
+    for (Node *node : AST)
     {
-        if (node->type == "TypeExpression")
-        {
-            TypeExpression *type = (TypeExpression*)node;
-
-            return_value = shared_ptr<TypeObject>(new TypeObject(InterpretType(*type, env)));
-        }
-        else if (node->type == "Literal")
-        {
-            Literal *literal = (Literal*)node;
+        pair<Value, RETURN_REASON> result = InterpretStatement(node, env, call_stack);
 
-            if (literal->l_integer)
-            {
-                return_value = shared_ptr<Object>(new IntObject(literal->l_integer.value()));
-            }
-            else if (literal->l_float)
-            {
-                return_value = shared_ptr<Object>(new FloatObject(literal->l_float.value()));
-            }
-            else if (literal->l_boolean)
-            {
-                return_value = shared_ptr<Object>(new BoolObject(literal->l_boolean.value()));
-            }
-            else if (literal->l_string)
-            {
-                return_value = shared_ptr<Object>(new StringObject(literal->l_string.value()));
-            }
-        }
-        else if (node->type == "CodeBlock")
+        if (get<1>(result) != EndOfAST)
         {
-            return_value = InterpretCodeBlock(*(CodeBlock*)node, env);
+            return result;
         }
-        else if (node->type == "Operation")
-        {
-            Operation *operation = (Operation*)node;
 
-            if (operation->left != NULL)
-            {
-                shared_ptr<Object> left = get<0>(Interpret({operation->left}, env, call_stack));
-                shared_ptr<Object> right = get<0>(Interpret({operation->right}, env, call_stack));
-
-                // Allow implicit casting
-                if (left->type != right->type)
-                {
-                    stringstream s;
-                    s << "'" << operation->operator_string << "' operation cannot be applied to type '" << left->type << "' and '" << right->type << "'";
+        return_value = move(get<0>(result));
+    }
 
-                    throw ErrorObject(operation->start, operation->end, Error {TypeError, s.str()});
-                }
+    return {return_value, EndOfAST};
+}
 
-                string func_name;
-
-                if (operation->operator_string == "^") func_name = "pow";
-                else if (operation->operator_string == "*") func_name = "multiply";
-                else if (operation->operator_string == "/") func_name = "divide";
-                else if (operation->operator_string == "$") func_name = "int_divide";
-                else if (operation->operator_string == "%") func_name = "modulo";
-                else if (operation->operator_string == "+") func_name = "add";
-                else if (operation->operator_string == "-") func_name = "subtract";
-                else if (operation->operator_string == "==") func_name = "equality";
-                else if (operation->operator_string == "!=") func_name = "inequality";
-                else if (operation->operator_string == ">=") func_name = "greater_equal";
-                else if (operation->operator_string == "<=") func_name = "less_equal";
-                else if (operation->operator_string == ">") func_name = "greater";
-                else if (operation->operator_string == "<") func_name = "less";
-                else if (operation->operator_string == "&") func_name = "and";
-                else if (operation->operator_string == "|") func_name = "or";
-                else if (operation->operator_string == "=") func_name = "assignment";
-                else if (operation->operator_string == "+=") func_name = "add_assignment";
-                else if (operation->operator_string == "-=") func_name = "subtract_assignment";
-                else if (operation->operator_string == "*=") func_name = "multiply_assignment";
-                else if (operation->operator_string == "/=") func_name = "divide_assignment";
-
-                optional<Member> type_def = ((TypeDefinitionObject*)left->type.type_definition.get())->GetMember(func_name);
-
-                if (!type_def)
-                {
-                    stringstream s;
-                    s << "No method on type '" << left->type << "' for '" << operation->operator_string << "' with type '" << right->type << "'";
+// Expressions never leave their statement early, so only the value is returned
+Value InterpretExpression(Node *node, const shared_ptr<Environment> &env, Call *call_stack)
+{
+    if (node != NULL && node->kind == LiteralNode)
+    {
+        return InterpretLiteral((Literal*)node);
+    }
 
-                    throw ErrorObject(operation->start, operation->end, Error {OperationError, s.str() });
-                }
+    if (node != NULL && node->kind == OperationNode)
+    {
+        return InterpretOperation((Operation*)node, env, call_stack, 0);
+    }
 
-                FunctionObject *operation_func = dynamic_cast<FunctionObject*>(type_def->object.get());
+    return get<0>(InterpretStatement(node, env, call_stack));
+}
 
-                if (!operation_func)
-                {
-                    stringstream s;
-                    s << "No method on type '" << left->type << "' for '" << operation->operator_string << "' with type '" << right->type << "'";
+pair<Value, RETURN_REASON> InterpretStatement(Node *node, const shared_ptr<Environment> &env, Call *call_stack)
+{
+    if (node == NULL)
+    {
+        return {Value(), EndOfAST};
+    }
 
-                    throw ErrorObject(operation->start, operation->end, Error {OperationError, s.str() });
-                }
+    if (StackExhausted())
+    {
+        throw ErrorObject(node->start, node->end, Error {RecursionError, "Maximum nesting depth exceeded"});
+    }
 
-                return_value = CallFunction(operation_func, { { "this", Variable(left, Qualifier()) }, { "other", Variable(right, Qualifier()) } }, env, call_stack);
-            }
-            else
-            {
-                shared_ptr<Object> right = get<0>(Interpret({operation->right}, env, call_stack));
+    Value return_value = Value();
 
-                string func_name;
+    switch (node->kind)
+    {
+        case TypeExpressionNode:
+        {
+            TypeExpression *type = (TypeExpression*)node;
 
-                if (operation->operator_string == "!") func_name = "not";
-                else if (operation->operator_string == "-") func_name = "negative";
-                else if (operation->operator_string == "+") func_name = "positive";
+            return_value = Value(shared_ptr<Object>(new TypeObject(InterpretType(*type, env))));
 
-                FunctionObject *operation_func = dynamic_cast<FunctionObject*>(((TypeDefinitionObject*)right->type.type_definition.get())->GetMember(func_name)->object.get());
+            break;
+        }
+        case LiteralNode:
+        {
+            return_value = InterpretLiteral((Literal*)node);
 
-                if (!operation_func)
-                {
-                    stringstream s;
-                    s << "No method on type '" << right->type << "' for '" << operation->operator_string << "'";
+            break;
+        }
+        case CodeBlockNode:
+        {
+            return_value = Value(InterpretCodeBlock((CodeBlock*)node, env));
 
-                    throw ErrorObject(operation->start, operation->end, Error {OperationError, s.str() });
-                }
+            break;
+        }
+        case OperationNode:
+        {
+            return_value = InterpretOperation((Operation*)node, env, call_stack, 0);
 
-                return_value = CallFunction(operation_func, { { "this", Variable(right, Qualifier()) } }, env, call_stack);
-            }
+            break;
         }
-        else if (node->type == "GetVariable")
+        case GetVariableNode:
         {
             GetVariable *get_variable = (GetVariable*)node;
 
-            optional<Variable> var = env->Get(get_variable->name);
+            Variable *var = env->Get(get_variable->name);
 
             if (!var)
             {
                 throw ErrorObject(get_variable->start, get_variable->end, Error {IdentifierError, "Identifier '" + get_variable->name + "' is not defined"});
             }
 
-            return_value = var.value().object;
+            return_value = var->value;
+
+            break;
         }
-        else if (node->type == "DeclareVariable")
+        case DeclareVariableNode:
         {
             DeclareVariable *declare_variable = (DeclareVariable*)node;
 
-            if (env->Get(declare_variable->name))
+            if (env->Declares(declare_variable->name))
             {
                 throw ErrorObject(declare_variable->start, declare_variable->end, Error {IdentifierError, "Identifier '" + declare_variable->name + "' is already declared"});
             }
 
-            Type type = InterpretType(declare_variable->variable_type, env);
-            
-            shared_ptr<Object> value = get<0>(Interpret({declare_variable->value}, env, call_stack));
-
-            if (value->type != type)
-            {
-                stringstream s;
-                s << "A value of type '" << value->type << "' cannot be used to declare a variable of type '" << type << "'";
+            Value value = InterpretExpression(declare_variable->value, env, call_stack);
 
-                throw ErrorObject(declare_variable->start, declare_variable->end, Error {TypeError, s.str()});
-            }
+            InterpretDeclaration(declare_variable, value, env);
 
-            env->Add(declare_variable->name, Variable(value, Qualifier(declare_variable->qualifier->qualifiers)));
+            return_value = Value();
 
-            return_value = shared_ptr<Object>(new VoidObject());
+            break;
         }
-        else if (node->type == "FunctionCall")
+        case FunctionCallNode:
         {
             FunctionCall *function_call = (FunctionCall*)node;
 
-            optional<Variable> func = env->Get(function_call->name);
-
-            if (!func)
-            {
-                throw ErrorObject(function_call->start, function_call->end, Error {IdentifierError, "Identifier '" + function_call->name + "' is not defined"});
-            }
-
-            FunctionObject *function = dynamic_cast<FunctionObject*>(func->object.get());
-
-            if (!function)
-            {
-                throw ErrorObject(function_call->start, function_call->end, Error {IdentifierError, "Identifier '" + function_call->name + "' is not a function"});
-            }
-
-            map<string, Variable> argument_values = {};
+            shared_ptr<Object> func = GetFunction(function_call, env);
 
-            // TODO: Deal with array and map arguments (* and **)
+            FunctionObject *function = (FunctionObject*)func.get();
 
-            for (int i = 0; i < function->parameters.size(); i++)
-            {
-                if (i >= function_call->arguments.size())
-                {
-                    if (!function->parameters[i].default_argument)
-                    {
-                        stringstream error;
-                        error << "Expected (";
-
-                        for (int p = 0; p < function->parameters.size(); p++)
-                        {
-                            error << function->parameters[p];
-                            if (p < function->parameters.size() - 1) error << ", ";
-                        }
-
-                        error << ") too few arguments";
-
-                        throw ErrorObject(function_call->start, function_call->end, Error {FunctionError, error.str()});
-                    }
-
-                    argument_values.insert({function->parameters[i].name, Variable(get<0>(Interpret({function->parameters[i].default_argument.value()}, env, call_stack)), Qualifier())});
-                }
-                else
-                {
-                    shared_ptr<Object> value = get<0>(Interpret({function_call->arguments[i]}, env, call_stack));
-
-                    if (function->parameters[i].type != value->type)
-                    {
-                        stringstream s;
-                        s << "A value of type '" << value->type << "' cannot be passed into parameter of type '" << function->parameters[i].type << "'";
-
-                        throw ErrorObject(function_call->arguments[i]->start, function_call->arguments[i]->end, Error {TypeError, s.str()});
-                    }
+            vector<Variable> argument_values = InterpretArguments(function, function_call, function_call->arguments, env, call_stack);
 
-                    argument_values.insert({function->parameters[i].name, Variable(value, Qualifier())});
-                }
-            }
+            return_value = CallFunction(function, argument_values, optional<Value>(), env, node, call_stack);
 
-            return_value = CallFunction(function, argument_values, env, call_stack);
+            break;
         }
-        else if (node->type == "ClassDefinition")
+        case ClassDefinitionNode:
         {
             ClassDefinition *class_definition = (ClassDefinition*)node;
 
@@ -242,246 +145,99 @@ pair<shared_ptr<Object>, RETURN_REASON> Interpret(vector<Node*> AST, shared_ptr<
 
             shared_ptr<Environment> class_env = shared_ptr<Environment>(new Environment(env, {}));
 
-            vector<Call> class_call_stack = vector<Call>(call_stack);
-            class_call_stack.push_back(Call("ClassDefinition", optional<Type>()));
+            Call class_call = Call(ClassDefinitionNode, optional<Type>(), node, call_stack);
 
-            Interpret(class_definition->body, class_env, class_call_stack);
+            Interpret(class_definition->body, class_env, &class_call);
 
-            map<string, Member> class_members = VariablesToMembers(class_env->variables);
+            DefineClass(class_definition, class_env, env);
 
-            // TODO: Add qualifiers
-            env->Add(class_definition->name, Variable(shared_ptr<Object>(new TypeDefinitionObject(class_definition->name, class_members)), Qualifier()));
+            return_value = Value();
 
-            return_value = shared_ptr<Object>(new VoidObject());
+            break;
         }
-        else if (node->type == "InstanceClass")
+        case InstanceClassNode:
         {
             InstanceClass *instance_class = (InstanceClass*)node;
 
-            optional<Variable> optional_definition = env->Get(instance_class->name);
-
-            if (!optional_definition)
-            {
-                throw ErrorObject(instance_class->start, instance_class->end, Error {ClassError, "No class with name '" + instance_class->name + "'"});
-            }
-
-            TypeDefinitionObject *definition = (TypeDefinitionObject*)optional_definition->object.get();
-
-            shared_ptr<Object> instance = shared_ptr<Object>(new ClassInstanceObject(optional_definition->object, {}));
-
-            optional<Member> optional_constructor = definition->GetMember(instance_class->name);
-
-            if (!optional_constructor)
-            {
-                return_value = instance;
-
-                continue;
-            }
-
-            map<string, Variable> class_methods = {};
-            map<string, Variable> class_attributes = {};
-
-            for (auto& [name, member] : definition->members)
-            {
-                if (dynamic_cast<FunctionObject*>(member.object.get()))
-                {
-                    class_methods.insert({ name, Variable(member.object, member.qualifiers) });
-                }
-                else
-                {
-                    class_attributes.insert({ name, Variable(member.object, member.qualifiers) });
-                }
-            }
-
-            class_attributes.insert({ "this", Variable(instance, Qualifier()) });
-
-            shared_ptr<Environment> class_env = shared_ptr<Environment>(new Environment(env, class_methods));
+            shared_ptr<Object> class_type = GetClassDefinition(instance_class, env);
 
-            shared_ptr<Environment> constructor_env = shared_ptr<Environment>(new Environment(class_env, class_attributes));
+            TypeDefinitionObject *definition = (TypeDefinitionObject*)class_type.get();
 
-            vector<Call> constructor_call_stack = vector<Call>(call_stack);
-            constructor_call_stack.push_back(Call("InstanceClass", optional<Type>(Type(env->Get("void")->object))));
+            shared_ptr<Object> instance = CreateInstance(class_type);
 
-            FunctionObject *constructor = dynamic_cast<FunctionObject*>(optional_constructor->object.get());
+            FunctionObject *constructor = GetConstructor(instance_class, definition);
 
             if (!constructor)
             {
-                throw ErrorObject(instance_class->start, instance_class->end, Error {ClassError, "Class member variable with constructor name"});
-            }
-
-            map<string, Variable> argument_values = {};
-
-            // TODO: Deal with array and map arguments (* and **)
-
-            for (int i = 0; i < constructor->parameters.size(); i++)
-            {
-                if (i >= instance_class->arguments.size())
-                {
-                    if (!constructor->parameters[i].default_argument)
-                    {
-                        stringstream error;
-                        error << "Expected (";
-
-                        for (int p = 0; p < constructor->parameters.size(); p++)
-                        {
-                            error << constructor->parameters[p];
-                            if (p < constructor->parameters.size() - 1) error << ", ";
-                        }
-
-                        error << ") too few arguments";
-
-                        throw ErrorObject(instance_class->start, instance_class->end, Error {FunctionError, error.str()});
-                    }
-
-                    argument_values.insert({constructor->parameters[i].name, Variable(get<0>(Interpret({constructor->parameters[i].default_argument.value()}, env, call_stack)), Qualifier())});
-                }
-                else
-                {
-                    shared_ptr<Object> value = get<0>(Interpret({instance_class->arguments[i]}, env, call_stack));
-
-                    if (constructor->parameters[i].type != value->type)
-                    {
-                        stringstream s;
-                        s << "A value of type '" << value->type << "' cannot be passed into parameter of type '" << constructor->parameters[i].type << "'";
-
-                        throw ErrorObject(instance_class->arguments[i]->start, instance_class->arguments[i]->end, Error {TypeError, s.str()});
-                    }
+                return_value = instance;
 
-                    argument_values.insert({constructor->parameters[i].name, Variable(value, Qualifier())});
-                }
+                break;
             }
 
-            CallFunction(constructor, argument_values, constructor_env, constructor_call_stack);
+            shared_ptr<Environment> constructor_env = CreateConstructorEnvironment(definition, instance, env);
 
-            map<string, Member> instance_members = {};
+            Call constructor_call = Call(InstanceClassNode, optional<Type>(Type(env->Get("void")->value.object)), node, call_stack);
 
-            for (auto& [member_name, member_value] : constructor_env->variables)
-            {
-                if (member_name != "this")
-                {
-                    instance_members.insert({member_name, Member(member_value.object, member_value.qualifiers)});
-                }
-            }
+            vector<Variable> argument_values = InterpretArguments(constructor, instance_class, instance_class->arguments, env, call_stack);
 
-            ((ClassInstanceObject*)instance.get())->members.insert(instance_members.begin(), instance_members.end());
+            CallFunction(constructor, argument_values, optional<Value>(), constructor_env, node, &constructor_call);
 
             return_value = instance;
+
+            break;
         }
-        else if (node->type == "MemberAccess")
+        case MemberAccessNode:
         {
             MemberAccess *member_access = (MemberAccess*)node;
 
-            optional<Variable> optional_type_definition = env->Get(member_access->name);
-
-            if (!optional_type_definition)
-            {
-                throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "No object with name '" + member_access->name + "'"});
-            }
-
-            ClassInstanceObject *object = dynamic_cast<ClassInstanceObject*>(optional_type_definition->object.get());
-
-            if (!object)
-            {
-                throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "Object '" + member_access->name + "' is not a class instance"});
-            }
-
-            string value_name;
-
-            if (member_access->statement->type == "GetVariable")
-            {
-                value_name = ((GetVariable*)member_access->statement)->name;
-            }
-            else if (member_access->statement->type == "FunctionCall")
-            {
-                value_name = ((FunctionCall*)member_access->statement)->name;
-            }
-
-            bool found_name = false;
-
-            for (auto& [name, _] : object->members)
-            {
-                if (name == value_name)
-                {
-                    found_name = true;
-                }
-            }
-
-            for (auto& [name, _] : ((TypeDefinitionObject*)object->type.type_definition.get())->members)
+            if (member_access->statement->kind == GetVariableNode)
             {
-                if (name == value_name)
-                {
-                    found_name = true;
-                }
-            }
+                return_value = GetMemberValue(member_access, env);
 
-            if (!found_name)
-            {
-                throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "'" + value_name + "' is not a member of this object"});
+                break;
             }
 
-            map<string, Variable> vars = MembersToVariables(object->members);
-            map<string, Variable> methods = MembersToVariables(((TypeDefinitionObject*)object->type.type_definition.get())->members);
-            vars.insert(methods.begin(), methods.end());
-            vars.insert({ "this", Variable(optional_type_definition->object, Qualifier()) });
+            shared_ptr<Environment> member_access_env = CreateMemberAccessEnvironment(member_access, env);
 
-            shared_ptr<Environment> member_access_env = shared_ptr<Environment>(new Environment(env, vars));
+            return_value = InterpretExpression(member_access->statement, member_access_env, call_stack);
 
-            return_value = get<0>(Interpret({member_access->statement}, member_access_env, call_stack));
+            break;
         }
-        else if (node->type == "IfStatement")
+        case IfStatementNode:
         {
             IfStatement *if_statement = (IfStatement*)node;
 
-            vector<Call> if_call_stack = vector<Call>(call_stack);
-            if_call_stack.push_back(Call("IfStatement", optional<Type>()));
-
-            shared_ptr<Object> if_expression = get<0>(Interpret({if_statement->if_expression}, env, if_call_stack));
-
-            BoolObject *expression_result = dynamic_cast<BoolObject*>(if_expression.get());
+            Call if_call = Call(IfStatementNode, optional<Type>(), node, call_stack);
 
-            if (!expression_result)
-            {
-                stringstream s;
-                s << "Expected value of type 'bool' instead of type '" << expression_result->type << "'";
-
-                throw ErrorObject(if_statement->if_expression->start, if_statement->if_expression->end, Error {TypeError, s.str()});
-            }
+            Value if_expression = InterpretExpression(if_statement->if_expression, env, &if_call);
 
-            if (expression_result->value)
+            if (GetCondition(if_expression, if_statement->if_expression))
             {
-                RETURN_REASON return_reason = get<1>(Interpret(if_statement->if_code_block->content, env, if_call_stack));
+                pair<Value, RETURN_REASON> result = Interpret(if_statement->if_code_block->content, env, &if_call);
 
-                if (return_reason != EndOfAST)
+                if (get<1>(result) != EndOfAST)
                 {
-                    return {shared_ptr<Object>(new VoidObject()), return_reason};
+                    return result;
                 }
 
-                continue;
+                return_value = Value();
+
+                break;
             }
 
             bool completed_else_if_expression = false;
 
             for (int i = 0; i < if_statement->else_if_expressions.size(); i++)
             {
-                shared_ptr<Object> else_if_expression = get<0>(Interpret({if_statement->else_if_expressions[i]}, env, if_call_stack));
-
-                BoolObject *expression_result = dynamic_cast<BoolObject*>(else_if_expression.get());
-
-                if (!expression_result)
-                {
-                    stringstream s;
-                    s << "Expected value of type 'bool' instead of type '" << expression_result->type << "'";
+                Value else_if_expression = InterpretExpression(if_statement->else_if_expressions[i], env, &if_call);
 
-                    throw ErrorObject(if_statement->else_if_expressions[i]->start, if_statement->else_if_expressions[i]->end, Error {TypeError, s.str()});
-                }
-
-                if (expression_result->value)
+                if (GetCondition(else_if_expression, if_statement->else_if_expressions[i]))
                 {
-                    RETURN_REASON return_reason = get<1>(Interpret(if_statement->else_if_code_blocks[i]->content, env, if_call_stack));
+                    pair<Value, RETURN_REASON> result = Interpret(if_statement->else_if_code_blocks[i]->content, env, &if_call);
 
-                    if (return_reason != EndOfAST)
+                    if (get<1>(result) != EndOfAST)
                     {
-                        return {shared_ptr<Object>(new VoidObject()), return_reason};
+                        return result;
                     }
 
                     completed_else_if_expression = true;
@@ -492,76 +248,54 @@ pair<shared_ptr<Object>, RETURN_REASON> Interpret(vector<Node*> AST, shared_ptr<
 
             if (if_statement->else_code_block && !completed_else_if_expression)
             {
-                RETURN_REASON return_reason = get<1>(Interpret(if_statement->else_code_block->content, env, if_call_stack));
+                pair<Value, RETURN_REASON> result = Interpret(if_statement->else_code_block->content, env, &if_call);
 
-                if (return_reason != EndOfAST)
+                if (get<1>(result) != EndOfAST)
                 {
-                    return {shared_ptr<Object>(new VoidObject()), return_reason};
+                    return result;
                 }
             }
 
-            return_value = shared_ptr<Object>(new VoidObject());
+            return_value = Value();
+
+            break;
         }
-        else if (node->type == "SwitchStatement")
+        case SwitchStatementNode:
         {
             SwitchStatement *switch_statement = (SwitchStatement*)node;
 
             bool completed_case_expression = false;
 
-            vector<Call> switch_call_stack = vector<Call>(call_stack);
-            switch_call_stack.push_back(Call("SwitchStatement", optional<Type>()));
+            Call switch_call = Call(SwitchStatementNode, optional<Type>(), node, call_stack);
 
-            shared_ptr<Object> switch_expression = get<0>(Interpret({switch_statement->switch_expression}, env, switch_call_stack));
+            Value switch_expression = InterpretExpression(switch_statement->switch_expression, env, &switch_call);
 
             for (int i = 0; i < switch_statement->case_expressions.size(); i++)
             {
-                shared_ptr<Object> case_expression = get<0>(Interpret({switch_statement->case_expressions[i]}, env, switch_call_stack));
-
-                if (switch_expression->type != case_expression->type)
-                {
-                    stringstream s;
-                    s << "type '" << switch_expression->type << "' is not the same as '" << case_expression->type << "'";
-
-                    throw ErrorObject(switch_statement->case_expressions[i]->start, switch_statement->case_expressions[i]->end, Error {TypeError, s.str()});
-                }
-
-                optional<Member> type_def = ((TypeDefinitionObject*)switch_expression->type.type_definition.get())->GetMember("equality");
+                Value case_expression = InterpretExpression(switch_statement->case_expressions[i], env, &switch_call);
 
-                if (!type_def)
-                {
-                    stringstream s;
-                    s << "No method on type '" << switch_expression->type << "' for '==' with type '" << case_expression->type << "'";
-
-                    throw ErrorObject(switch_statement->case_expressions[i]->start, switch_statement->case_expressions[i]->end, Error {OperationError, s.str() });
-                }
+                FunctionObject *operation_func = GetCaseMethod(switch_statement->case_expressions[i], switch_expression, case_expression);
 
-                FunctionObject *operation_func = dynamic_cast<FunctionObject*>(type_def->object.get());
+                Value is_case_correct;
 
-                if (!operation_func)
+                if (operation_func->body.index() == 1)
                 {
-                    stringstream s;
-                    s << "No method on type '" << switch_expression->type << "' for '==' with type '" << case_expression->type << "'";
+                    Value operands[] = { switch_expression, case_expression };
 
-                    throw ErrorObject(switch_statement->case_expressions[i]->start, switch_statement->case_expressions[i]->end, Error {OperationError, s.str() });
+                    is_case_correct = get<1>(operation_func->body)(operands, 2);
                 }
-
-                BoolObject *is_case_correct = dynamic_cast<BoolObject*>(CallFunction(operation_func, { { "this", Variable(switch_expression, Qualifier()) }, { "other", Variable(case_expression, Qualifier()) } }, env, call_stack).get());
-
-                if (!is_case_correct)
+                else
                 {
-                    stringstream s;
-                    s << "Comparison of type '" << switch_expression->type << "' with type '" << case_expression->type << "' does not return a boolean";
-
-                    throw ErrorObject(switch_statement->case_expressions[i]->start, switch_statement->case_expressions[i]->end, Error {OperationError, s.str() });
+                    is_case_correct = CallFunction(operation_func, { Variable(case_expression, Qualifier()) }, switch_expression, env, switch_statement->case_expressions[i], &switch_call);
                 }
 
-                if (is_case_correct->value)
+                if (GetCaseResult(switch_statement->case_expressions[i], is_case_correct, switch_expression, case_expression))
                 {
-                    RETURN_REASON return_reason = get<1>(Interpret(switch_statement->case_code_blocks[i]->content, env, switch_call_stack));
+                    pair<Value, RETURN_REASON> result = Interpret(switch_statement->case_code_blocks[i]->content, env, &switch_call);
 
-                    if (return_reason != EndOfAST)
+                    if (get<1>(result) != EndOfAST)
                     {
-                        return {shared_ptr<Object>(new VoidObject()), return_reason};
+                        return result;
                     }
 
                     completed_case_expression = true;
@@ -572,180 +306,929 @@ pair<shared_ptr<Object>, RETURN_REASON> Interpret(vector<Node*> AST, shared_ptr<
 
             if (switch_statement->default_code_block && !completed_case_expression)
             {
-                RETURN_REASON return_reason = get<1>(Interpret(switch_statement->default_code_block->content, env, switch_call_stack));
+                pair<Value, RETURN_REASON> result = Interpret(switch_statement->default_code_block->content, env, &switch_call);
 
-                if (return_reason != EndOfAST)
+                if (get<1>(result) != EndOfAST)
                 {
-                    return {shared_ptr<Object>(new VoidObject()), return_reason};
+                    return result;
                 }
             }
+
+            return_value = Value();
+
+            break;
         }
-        else if (node->type == "ForLoop")
+        case ForLoopNode:
         {
             ForLoop *for_loop = (ForLoop*)node;
 
             shared_ptr<Environment> for_env = shared_ptr<Environment>(new Environment(env, {}));
 
-            vector<Call> for_call_stack = vector<Call>(call_stack);
-            for_call_stack.push_back(Call("ForLoop", optional<Type>()));
-
-            Interpret({for_loop->declaration_expression}, for_env, for_call_stack);
+            Call for_call = Call(ForLoopNode, optional<Type>(), node, call_stack);
 
-            bool continue_looping = true;
+            InterpretExpression(for_loop->declaration_expression, for_env, &for_call);
 
-            while (continue_looping)
+            while (true)
             {
-                shared_ptr<Object> value = get<0>(Interpret({for_loop->condition_expression}, for_env, for_call_stack));
-                
-                BoolObject *expression_result = dynamic_cast<BoolObject*>(value.get());
-
-                if (!expression_result)
+                if (for_loop->condition_expression != NULL)
                 {
-                    stringstream s;
-                    s << "Expected value of type 'bool' instead of type '" << expression_result->type << "'";
-
-                    throw ErrorObject(for_loop->condition_expression->start, for_loop->condition_expression->end, Error {TypeError, s.str()});
-                }
+                    Value value = InterpretExpression(for_loop->condition_expression, for_env, &for_call);
 
-                if (!expression_result->value)
-                {
-                    continue_looping = false;
-                    break;
+                    if (!GetCondition(value, for_loop->condition_expression))
+                    {
+                        break;
+                    }
                 }
 
-                shared_ptr<Environment> this_env = shared_ptr<Environment>(new Environment(for_env, {}));
+                shared_ptr<Environment> this_env = for_loop->for_code_block->declares ? shared_ptr<Environment>(new Environment(for_env, {})) : for_env;
 
-                RETURN_REASON return_reason = get<1>(Interpret(for_loop->for_code_block->content, this_env, for_call_stack));
+                pair<Value, RETURN_REASON> result = Interpret(for_loop->for_code_block->content, this_env, &for_call);
 
-                if (return_reason == ReturnStatement)
+                if (get<1>(result) == ReturnStatement || get<1>(result) == TailCallStatement)
                 {
-                    return {shared_ptr<Object>(new VoidObject()), return_reason};
+                    return result;
                 }
-                else if (return_reason == BreakStatement)
+                else if (get<1>(result) == BreakStatement)
                 {
-                    continue;
+                    break;
                 }
 
-                Interpret({for_loop->iteration_expression}, for_env, for_call_stack);
+                InterpretExpression(for_loop->iteration_expression, for_env, &for_call);
             }
+
+            return_value = Value();
+
+            break;
         }
-        else if (node->type == "ForEachLoop")
+        case ForEachLoopNode:
         {
             // TODO: Only possible when iterative types exist
+
+            return_value = Value();
+
+            break;
         }
-        else if (node->type == "WhileLoop")
+        case WhileLoopNode:
         {
             WhileLoop *while_loop = (WhileLoop*)node;
 
-            vector<Call> while_call_stack = vector<Call>(call_stack);
-            while_call_stack.push_back(Call("WhileLoop", optional<Type>()));
+            Call while_call = Call(WhileLoopNode, optional<Type>(), node, call_stack);
 
-            bool continue_looping = true;
-
-            while (continue_looping)
+            while (true)
             {
-                shared_ptr<Object> value = get<0>(Interpret({while_loop->condition}, env, while_call_stack));
-                
-                BoolObject *expression_result = dynamic_cast<BoolObject*>(value.get());
-
-                if (!expression_result)
-                {
-                    stringstream s;
-                    s << "Expected value of type 'bool' instead of type '" << expression_result->type << "'";
-
-                    throw ErrorObject(while_loop->condition->start, while_loop->condition->end, Error {TypeError, s.str()});
-                }
+                Value value = InterpretExpression(while_loop->condition, env, &while_call);
 
-                if (!expression_result->value)
+                if (!GetCondition(value, while_loop->condition))
                 {
-                    continue_looping = false;
                     break;
                 }
 
-                shared_ptr<Environment> while_env = shared_ptr<Environment>(new Environment(env, {}));
+                shared_ptr<Environment> while_env = while_loop->while_code_block->declares ? shared_ptr<Environment>(new Environment(env, {})) : env;
 
-                RETURN_REASON return_reason = get<1>(Interpret(while_loop->while_code_block->content, while_env, while_call_stack));
+                pair<Value, RETURN_REASON> result = Interpret(while_loop->while_code_block->content, while_env, &while_call);
 
-                if (return_reason == ReturnStatement)
+                if (get<1>(result) == ReturnStatement || get<1>(result) == TailCallStatement)
                 {
-                    return {shared_ptr<Object>(new VoidObject()), return_reason};
+                    return result;
                 }
-                else if (return_reason == BreakStatement)
+                else if (get<1>(result) == BreakStatement)
                 {
-                    continue;
+                    break;
                 }
             }
+
+            return_value = Value();
+
+            break;
         }
-        else if (node->type == "Return")
+        case ReturnNode:
         {
             Return *return_node = (Return*)node;
 
-            shared_ptr<Object> value = get<0>(Interpret({return_node->expression}, env, call_stack));
+            if (return_node->tail_call)
+            {
+                FunctionCall *function_call = (FunctionCall*)return_node->expression;
+
+                Call *func_call = call_stack;
+
+                while (func_call->node_kind != FunctionCallNode)
+                {
+                    func_call = func_call->parent;
+                }
+
+                func_call->tail_function = GetFunction(function_call, env);
+                func_call->tail_arguments = InterpretArguments((FunctionObject*)func_call->tail_function.get(), function_call, function_call->arguments, env, call_stack);
+                func_call->node = function_call;
+
+                return {Value(), TailCallStatement};
+            }
+
+            Value value = InterpretExpression(return_node->expression, env, call_stack);
 
             return {value, ReturnStatement};
         }
-        else if (node->type == "Break")
+        case BreakNode:
         {
-            return {shared_ptr<Object>(new VoidObject()), BreakStatement};
+            return {Value(), BreakStatement};
         }
-        else if (node->type == "Continue")
+        case ContinueNode:
         {
-            return {shared_ptr<Object>(new VoidObject()), ContinueStatement};
+            return {Value(), ContinueStatement};
         }
     }
 
     return {return_value, EndOfAST};
 }
 
-Type InterpretType(TypeExpression type_expression, shared_ptr<Environment> env)
+Value InterpretOperation(Operation *operation, const shared_ptr<Environment> &env, Call *call_stack, int depth)
 {
-    optional<Variable> var = env->Get(type_expression.name);
-
-    if (var && dynamic_cast<TypeDefinitionObject*>(var->object.get()))
+    if (depth < Operation_Recursion_Limit)
     {
-        Type type = Type(var->object);
+        Value left = Value();
 
-        // TODO: More complex types (with generics)
+        if (operation->left != NULL && operation->left->kind == OperationNode)
+        {
+            left = InterpretOperation((Operation*)operation->left, env, call_stack, depth + 1);
+        }
+        else if (operation->left != NULL)
+        {
+            left = InterpretExpression(operation->left, env, call_stack);
+        }
 
-        return type;
+        Value right = operation->right->kind == OperationNode ? InterpretOperation((Operation*)operation->right, env, call_stack, depth + 1) : InterpretExpression(operation->right, env, call_stack);
+
+        return ApplyOperation(operation, left, right, env, call_stack);
     }
-    else
+
+    // Deeper operation trees continue on explicit stacks, so long chains of operators only take heap memory.
+    // Each pending node is visited once to queue its operands and again to apply its operator.
+    vector<pair<Node*, bool>> pending = { {operation, false} };
+    vector<Value> values = {};
+
+    while (pending.size() != 0)
     {
-        throw ErrorObject(type_expression.start, type_expression.end, Error {TypeError, "The type '" + type_expression.name + "' is undefined"});
+        pair<Node*, bool> current = pending.back();
+        pending.pop_back();
+
+        Node *node = get<0>(current);
+
+        if (node == NULL || node->kind != OperationNode)
+        {
+            values.push_back(InterpretExpression(node, env, call_stack));
+
+            continue;
+        }
+
+        Operation *current_operation = (Operation*)node;
+
+        if (!get<1>(current))
+        {
+            // The left operand is queued last so it is evaluated first
+            pending.push_back({current_operation, true});
+            pending.push_back({current_operation->right, false});
+
+            if (current_operation->left != NULL)
+            {
+                pending.push_back({current_operation->left, false});
+            }
+
+            continue;
+        }
+
+        Value right = values.back();
+        values.pop_back();
+
+        Value left = Value();
+
+        if (current_operation->left != NULL)
+        {
+            left = values.back();
+            values.pop_back();
+        }
+
+        values.push_back(ApplyOperation(current_operation, left, right, env, call_stack));
     }
+
+    return values.back();
 }
 
-shared_ptr<FunctionObject> InterpretCodeBlock(CodeBlock code_block, shared_ptr<Environment> env)
+Value ApplyOperation(Operation *operation, const Value &left, const Value &right, const shared_ptr<Environment> &env, Call *call_stack)
 {
-    Type return_type = InterpretType(code_block.return_type, env);
-
-    vector<Parameter> parameters = {};
-
-    for (ParameterExpression p : code_block.parameters)
+    if (operation->left == NULL)
     {
-        Type p_type = InterpretType(p.type_data, env);
+        FunctionObject *operation_func = GetOperatorMethod(operation, Value(), right);
 
-        parameters.push_back(Parameter(p_type, p.name, p.default_argument, p.argument_expansion));
+        if (operation_func->body.index() == 1)
+        {
+            return get<1>(operation_func->body)(&right, 1);
+        }
+
+        return CallFunction(operation_func, {}, right, env, operation, call_stack);
     }
 
-    vector<Node*> body = code_block.content;
+    FunctionObject *operation_func = GetOperatorMethod(operation, left, right);
 
-    return shared_ptr<FunctionObject>(new FunctionObject(return_type, parameters, body));
-}
+    Value return_value;
 
-shared_ptr<Object> CallFunction(FunctionObject *function, map<string, Variable> argument_values, shared_ptr<Environment> env, vector<Call> call_stack)
-{
-    shared_ptr<Environment> func_env = shared_ptr<Environment>(new Environment(env, argument_values));
+    if (operation_func->body.index() == 1)
+    {
+        Value operands[] = { left, right };
 
-    if (function->body.index() == 0)
-    {   
-        vector<Call> func_call_stack = vector<Call>(call_stack);
-        func_call_stack.push_back(Call("FunctionCall", function->return_type));
-        
-        return get<0>(Interpret(get<0>(function->body), func_env, func_call_stack));
+        return_value = get<1>(operation_func->body)(operands, 2);
     }
     else
     {
-        return get<1>(function->body)(func_env);
+        return_value = CallFunction(operation_func, { Variable(right, Qualifier()) }, left, env, operation, call_stack);
     }
-}
\ No newline at end of file
+
+    if (IsAssignment(operation->operator_code))
+    {
+        AssignValue(operation->left, return_value, env);
+
+        return Value();
+    }
+
+    return return_value;
+}
+
+Type InterpretType(TypeExpression &type_expression, const shared_ptr<Environment> &env)
+{
+    if (type_expression.cached_generation == Type_Generation)
+    {
+        return Type(type_expression.cached_type);
+    }
+
+    Variable *var = env->Get(type_expression.name);
+
+    if (var && ObjectCast<TypeDefinitionObject>(var->value.object.get()))
+    {
+        Type type = Type(var->value.object);
+
+        type_expression.cached_type = var->value.object;
+        type_expression.cached_generation = Type_Generation;
+
+        // TODO: More complex types (with generics)
+
+        return type;
+    }
+    else
+    {
+        throw ErrorObject(type_expression.start, type_expression.end, Error {TypeError, "The type '" + type_expression.name + "' is undefined"});
+    }
+}
+
+shared_ptr<FunctionObject> InterpretCodeBlock(CodeBlock *code_block, const shared_ptr<Environment> &env)
+{
+    Type return_type = InterpretType(code_block->return_type, env);
+
+    shared_ptr<FunctionObject> &prototype = code_block->prototype;
+
+    // Functions do not capture their environment, so a new object is only needed when a type now names another class
+    bool reusable = prototype && prototype->return_type == return_type;
+
+    for (int i = 0; reusable && i < code_block->parameters.size(); i++)
+    {
+        reusable = prototype->parameters[i].type == InterpretType(code_block->parameters[i].type_data, env);
+    }
+
+    if (reusable)
+    {
+        return prototype;
+    }
+
+    vector<Parameter> parameters = {};
+
+    for (ParameterExpression &p : code_block->parameters)
+    {
+        Type p_type = InterpretType(p.type_data, env);
+
+        parameters.push_back(Parameter(p_type, p.name, p.default_argument, p.argument_expansion));
+    }
+
+    prototype = shared_ptr<FunctionObject>(new FunctionObject(return_type, parameters, code_block->content));
+
+    return prototype;
+}
+
+vector<Variable> InterpretArguments(FunctionObject *function, Node *call, vector<Node*> arguments, shared_ptr<Environment> env, Call *call_stack)
+{
+    vector<Variable> argument_values = {};
+
+    // TODO: Deal with array and map arguments (* and **)
+
+    for (int i = 0; i < function->parameters.size(); i++)
+    {
+        if (i >= arguments.size())
+        {
+            Parameter &parameter = function->parameters[i];
+
+            if (!parameter.default_argument)
+            {
+                ThrowTooFewArguments(function, call);
+            }
+
+            if (parameter.default_value)
+            {
+                argument_values.push_back(Variable(parameter.default_value.value(), Qualifier()));
+
+                continue;
+            }
+
+            Value value = InterpretExpression(parameter.default_argument.value(), env, call_stack);
+
+            // Constant defaults give the same value on every call so they are only evaluated once
+            if (IsConstantExpression(parameter.default_argument.value()))
+            {
+                parameter.default_value = value;
+            }
+
+            argument_values.push_back(Variable(value, Qualifier()));
+        }
+        else
+        {
+            Value value = InterpretExpression(arguments[i], env, call_stack);
+
+            CheckArgument(function->parameters[i], value, arguments[i]);
+
+            argument_values.push_back(Variable(value, Qualifier()));
+        }
+    }
+
+    return argument_values;
+}
+
+Value CallFunction(FunctionObject *function, vector<Variable> argument_values, optional<Value> self, shared_ptr<Environment> env, Node *call, Call *call_stack)
+{
+    Call func_call = Call(FunctionCallNode, function->return_type, call, call_stack);
+
+    if (func_call.depth > Max_Call_Depth)
+    {
+        throw ErrorObject(call->start, call->end, Error {RecursionError, "Maximum recursion depth exceeded"});
+    }
+
+    // A call in tail position replaces the current one in this loop, so tail recursion runs in constant stack
+    shared_ptr<Object> tail_function = NULL;
+
+    while (true)
+    {
+        if (function->body.index() == 1)
+        {
+            // Natives take their arguments in parameter order, with the instance first for methods
+            vector<Value> arguments = {};
+
+            if (self)
+            {
+                arguments.push_back(self.value());
+            }
+
+            for (Variable &argument : argument_values)
+            {
+                arguments.push_back(argument.value);
+            }
+
+            return get<1>(function->body)(arguments.data(), arguments.size());
+        }
+
+        // Arguments are bound positionally into a frame laid out from the parameter list
+        shared_ptr<Environment> func_env = shared_ptr<Environment>(new Environment(env, function->parameters.size()));
+        func_env->slot_names = function->parameter_names;
+
+        for (int i = 0; i < argument_values.size() && i < function->parameters.size(); i++)
+        {
+            func_env->Set(i, function->parameters[i].name, argument_values[i]);
+        }
+
+        if (self)
+        {
+            func_env->Add("this", Variable(self.value(), Qualifier()));
+        }
+
+        pair<Value, RETURN_REASON> result;
+
+        try
+        {
+            result = Interpret(get<0>(function->body), func_env, &func_call);
+        }
+        catch (ErrorObject &error)
+        {
+            // The innermost call records the trace, the frames are still linked while the error unwinds
+            if (error.stack_trace.size() == 0)
+            {
+                error.stack_trace = GetStackTrace(&func_call);
+            }
+
+            throw;
+        }
+
+        if (get<1>(result) != TailCallStatement)
+        {
+            return get<0>(result);
+        }
+
+        // A name that resolved to another function at run time may still read this frame, so it runs as a normal call
+        if (func_call.tail_function.get() != function)
+        {
+            shared_ptr<Object> callee = move(func_call.tail_function);
+            Node *callee_node = func_call.node;
+
+            func_call.node = call;
+
+            return CallFunction((FunctionObject*)callee.get(), move(func_call.tail_arguments), optional<Value>(), func_env, callee_node, &func_call);
+        }
+
+        tail_function = move(func_call.tail_function);
+        function = (FunctionObject*)tail_function.get();
+        argument_values = move(func_call.tail_arguments);
+        self = optional<Value>();
+        func_call.return_type = function->return_type;
+    }
+}
+
+vector<TraceFrame> GetStackTrace(Call *call_stack)
+{
+    vector<TraceFrame> stack_trace = {};
+
+    for (Call *call = call_stack; call != NULL; call = call->parent)
+    {
+        if (call->node_kind == FunctionCallNode && call->node != NULL)
+        {
+            stack_trace.push_back(TraceFrame {GetCallName(call->node), call->node->start, call->node->end});
+        }
+    }
+
+    return stack_trace;
+}
+
+string GetCallName(Node *call)
+{
+    switch (call->kind)
+    {
+        case FunctionCallNode:
+        {
+            return ((FunctionCall*)call)->name;
+        }
+        case InstanceClassNode:
+        {
+            return ((InstanceClass*)call)->name;
+        }
+        case OperationNode:
+        {
+            return "operator" + ((Operation*)call)->operator_string;
+        }
+        default:
+        {
+            return "switch case";
+        }
+    }
+}
+
+bool IsConstantExpression(Node *expression)
+{
+    if (expression->kind == LiteralNode)
+    {
+        return true;
+    }
+
+    if (expression->kind == OperationNode)
+    {
+        Operation *operation = (Operation*)expression;
+
+        return !IsAssignment(operation->operator_code) && (operation->left == NULL || IsConstantExpression(operation->left)) && IsConstantExpression(operation->right);
+    }
+
+    return false;
+}
+Value InterpretLiteral(Literal *literal)
+{
+    if (literal->l_integer)
+    {
+        return Value(literal->l_integer.value());
+    }
+    else if (literal->l_float)
+    {
+        return Value((float)literal->l_float.value());
+    }
+    else if (literal->l_boolean)
+    {
+        return Value(literal->l_boolean.value());
+    }
+    else if (literal->l_string)
+    {
+        if (!literal->constant)
+        {
+            literal->constant = shared_ptr<Object>(new StringObject(literal->l_string.value()));
+        }
+
+        return Value(literal->constant);
+    }
+
+    return Value();
+}
+
+string GetOperatorMethodName(OPERATOR operator_code)
+{
+    switch (operator_code)
+    {
+        case NotOperator: return "not";
+        case NegativeOperator: return "negative";
+        case PositiveOperator: return "positive";
+        case PowOperator: return "pow";
+        case MultiplyOperator: return "multiply";
+        case DivideOperator: return "divide";
+        case IntDivideOperator: return "int_divide";
+        case ModuloOperator: return "modulo";
+        case AddOperator: return "add";
+        case SubtractOperator: return "subtract";
+        case EqualityOperator: return "equality";
+        case InequalityOperator: return "inequality";
+        case GreaterEqualOperator: return "greater_equal";
+        case LessEqualOperator: return "less_equal";
+        case GreaterOperator: return "greater";
+        case LessOperator: return "less";
+        case AndOperator: return "and";
+        case OrOperator: return "or";
+        case AssignmentOperator: return "assignment";
+        case AddAssignmentOperator: return "add_assignment";
+        case SubtractAssignmentOperator: return "subtract_assignment";
+        case MultiplyAssignmentOperator: return "multiply_assignment";
+        case DivideAssignmentOperator: return "divide_assignment";
+        case UnknownOperator: return "";
+    }
+
+    return "";
+}
+
+FunctionObject *GetOperatorMethod(Operation *operation, const Value &left, const Value &right)
+{
+    if (operation->left == NULL)
+    {
+        FunctionObject *operation_func = (FunctionObject*)operation->cache.Find(right.GetTypeDefinition());
+
+        if (operation_func)
+        {
+            return operation_func;
+        }
+
+        shared_ptr<Object> type_definition = right.GetType().type_definition;
+
+        optional<Member> type_def = ((TypeDefinitionObject*)type_definition.get())->GetMember(GetOperatorMethodName(operation->operator_code));
+
+        operation_func = type_def ? ObjectCast<FunctionObject>(type_def->value.object.get()) : NULL;
+
+        if (!operation_func)
+        {
+            stringstream s;
+            s << "No method on type '" << right.GetType() << "' for '" << operation->operator_string << "'";
+
+            throw ErrorObject(operation->start, operation->end, Error {OperationError, s.str() });
+        }
+
+        operation->cache.Add(type_definition, type_def->value.object);
+
+        return operation_func;
+    }
+
+    // Allow implicit casting
+    if (left.GetTypeDefinition() != right.GetTypeDefinition())
+    {
+        stringstream s;
+        s << "'" << operation->operator_string << "' operation cannot be applied to type '" << left.GetType() << "' and '" << right.GetType() << "'";
+
+        throw ErrorObject(operation->start, operation->end, Error {TypeError, s.str()});
+    }
+
+    FunctionObject *operation_func = (FunctionObject*)operation->cache.Find(left.GetTypeDefinition());
+
+    if (operation_func)
+    {
+        return operation_func;
+    }
+
+    shared_ptr<Object> type_definition = left.GetType().type_definition;
+
+    optional<Member> type_def = ((TypeDefinitionObject*)type_definition.get())->GetMember(GetOperatorMethodName(operation->operator_code));
+
+    operation_func = type_def ? ObjectCast<FunctionObject>(type_def->value.object.get()) : NULL;
+
+    if (!operation_func)
+    {
+        stringstream s;
+        s << "No method on type '" << left.GetType() << "' for '" << operation->operator_string << "' with type '" << right.GetType() << "'";
+
+        throw ErrorObject(operation->start, operation->end, Error {OperationError, s.str() });
+    }
+
+    operation->cache.Add(type_definition, type_def->value.object);
+
+    return operation_func;
+}
+
+bool GetCondition(Value value, Node *expression)
+{
+    if (value.tag != BoolValue)
+    {
+        stringstream s;
+        s << "Expected value of type 'bool' instead of type '" << value.GetType() << "'";
+
+        throw ErrorObject(expression->start, expression->end, Error {TypeError, s.str()});
+    }
+
+    return value.bool_value;
+}
+
+void InterpretDeclaration(DeclareVariable *declare_variable, Value value, shared_ptr<Environment> env, int slot)
+{
+    Type type = InterpretType(declare_variable->variable_type, env);
+
+    if (value.GetTypeDefinition() != type.type_definition.get())
+    {
+        stringstream s;
+        s << "A value of type '" << value.GetType() << "' cannot be used to declare a variable of type '" << type << "'";
+
+        throw ErrorObject(declare_variable->start, declare_variable->end, Error {TypeError, s.str()});
+    }
+
+    if (slot >= 0)
+    {
+        env->Set(slot, declare_variable->name, Variable(value, Qualifier(declare_variable->qualifier->qualifiers)));
+    }
+    else
+    {
+        env->Add(declare_variable->name, Variable(value, Qualifier(declare_variable->qualifier->qualifiers)));
+    }
+}
+
+shared_ptr<Object> GetFunction(FunctionCall *function_call, shared_ptr<Environment> env, int depth, int slot)
+{
+    Variable *func = env->Find(function_call->name, depth, slot);
+
+    if (!func)
+    {
+        throw ErrorObject(function_call->start, function_call->end, Error {IdentifierError, "Identifier '" + function_call->name + "' is not defined"});
+    }
+
+    if (!ObjectCast<FunctionObject>(func->value.object.get()))
+    {
+        throw ErrorObject(function_call->start, function_call->end, Error {IdentifierError, "Identifier '" + function_call->name + "' is not a function"});
+    }
+
+    return func->value.object;
+}
+
+void CheckArgument(const Parameter &parameter, const Value &value, Node *argument)
+{
+    if (parameter.type.type_definition.get() != value.GetTypeDefinition())
+    {
+        stringstream s;
+        s << "A value of type '" << value.GetType() << "' cannot be passed into parameter of type '" << parameter.type << "'";
+
+        throw ErrorObject(argument->start, argument->end, Error {TypeError, s.str()});
+    }
+}
+
+void ThrowTooFewArguments(FunctionObject *function, Node *call)
+{
+    stringstream error;
+    error << "Expected (";
+
+    for (int p = 0; p < function->parameters.size(); p++)
+    {
+        error << function->parameters[p];
+        if (p < function->parameters.size() - 1) error << ", ";
+    }
+
+    error << ") too few arguments";
+
+    throw ErrorObject(call->start, call->end, Error {FunctionError, error.str()});
+}
+
+void DefineClass(ClassDefinition *class_definition, shared_ptr<Environment> class_env, shared_ptr<Environment> env)
+{
+    map<string, Member> class_members = VariablesToMembers(class_env->Variables());
+
+    // TODO: Add qualifiers
+    env->Add(class_definition->name, Variable(shared_ptr<Object>(new TypeDefinitionObject(class_definition->name, class_members)), Qualifier()));
+
+    env->defines_classes = true;
+
+    Type_Generation++;
+}
+
+shared_ptr<Object> GetClassDefinition(InstanceClass *instance_class, shared_ptr<Environment> env)
+{
+    Variable *optional_definition = env->Get(instance_class->name);
+
+    if (!optional_definition || !ObjectCast<TypeDefinitionObject>(optional_definition->value.object.get()))
+    {
+        throw ErrorObject(instance_class->start, instance_class->end, Error {ClassError, "No class with name '" + instance_class->name + "'"});
+    }
+
+    return optional_definition->value.object;
+}
+
+FunctionObject *GetConstructor(InstanceClass *instance_class, TypeDefinitionObject *definition)
+{
+    optional<Member> optional_constructor = definition->GetMember(instance_class->name);
+
+    if (!optional_constructor)
+    {
+        return NULL;
+    }
+
+    FunctionObject *constructor = ObjectCast<FunctionObject>(optional_constructor->value.object.get());
+
+    if (!constructor)
+    {
+        throw ErrorObject(instance_class->start, instance_class->end, Error {ClassError, "Class member variable with constructor name"});
+    }
+
+    return constructor;
+}
+
+shared_ptr<Environment> CreateConstructorEnvironment(TypeDefinitionObject *definition, shared_ptr<Object> instance, shared_ptr<Environment> env)
+{
+    map<string, Variable> class_methods = {};
+
+    for (auto& [name, member] : definition->members)
+    {
+        if (ObjectCast<FunctionObject>(member.value.object.get()))
+        {
+            class_methods.insert({ name, Variable(member.value, member.qualifiers) });
+        }
+    }
+
+    shared_ptr<Environment> class_env = shared_ptr<Environment>(new Environment(env, class_methods));
+
+    // The constructor writes the attributes straight into the slots of the instance
+    shared_ptr<Environment> constructor_env = shared_ptr<Environment>(new Environment(class_env, 0));
+
+    constructor_env->instance = instance;
+    constructor_env->Add("this", Variable(instance, Qualifier()));
+
+    return constructor_env;
+}
+
+Variable *GetInstanceVariable(MemberAccess *member_access, shared_ptr<Environment> env, int depth, int slot)
+{
+    Variable *optional_type_definition = env->Find(member_access->name, depth, slot);
+
+    if (!optional_type_definition)
+    {
+        throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "No object with name '" + member_access->name + "'"});
+    }
+
+    if (!ObjectCast<ClassInstanceObject>(optional_type_definition->value.object.get()))
+    {
+        throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "Object '" + member_access->name + "' is not a class instance"});
+    }
+
+    return optional_type_definition;
+}
+
+Value GetMemberValue(MemberAccess *member_access, shared_ptr<Environment> env, int depth, int slot)
+{
+    ClassInstanceObject *object = (ClassInstanceObject*)GetInstanceVariable(member_access, env, depth, slot)->value.object.get();
+
+    // Reading one member loads its slot directly, the slot is looked up again only when a different class shows up at this site
+    if (member_access->cached_class != object->type.type_definition)
+    {
+        TypeDefinitionObject *definition = (TypeDefinitionObject*)object->type.type_definition.get();
+
+        string value_name = ((GetVariable*)member_access->statement)->name;
+
+        if (definition->members.find(value_name) == definition->members.end())
+        {
+            throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "'" + value_name + "' is not a member of this object"});
+        }
+
+        member_access->cached_class = object->type.type_definition;
+        member_access->cached_slot = definition->shape.Find(value_name);
+    }
+
+    if (member_access->cached_slot != -1)
+    {
+        return object->slots[member_access->cached_slot].value;
+    }
+
+    return ((TypeDefinitionObject*)member_access->cached_class.get())->members.find(((GetVariable*)member_access->statement)->name)->second.value;
+}
+
+shared_ptr<Environment> CreateMemberAccessEnvironment(MemberAccess *member_access, shared_ptr<Environment> env, int depth, int slot)
+{
+    Variable *optional_type_definition = GetInstanceVariable(member_access, env, depth, slot);
+
+    ClassInstanceObject *object = (ClassInstanceObject*)optional_type_definition->value.object.get();
+
+    string value_name;
+
+    if (member_access->statement->kind == GetVariableNode)
+    {
+        value_name = ((GetVariable*)member_access->statement)->name;
+    }
+    else if (member_access->statement->kind == FunctionCallNode)
+    {
+        value_name = ((FunctionCall*)member_access->statement)->name;
+    }
+
+    TypeDefinitionObject *definition = (TypeDefinitionObject*)object->type.type_definition.get();
+
+    if (definition->members.find(value_name) == definition->members.end())
+    {
+        throw ErrorObject(member_access->start, member_access->end, Error {IdentifierError, "'" + value_name + "' is not a member of this object"});
+    }
+
+    // Attributes are read and written in the slots of the instance, so a change through another reference to it is seen at once
+    shared_ptr<Environment> member_access_env = shared_ptr<Environment>(new Environment(env, 0));
+
+    member_access_env->instance = optional_type_definition->value.object;
+
+    for (auto& [name, member] : definition->members)
+    {
+        if (definition->shape.Find(name) == -1)
+        {
+            member_access_env->Add(name, Variable(member.value, member.qualifiers));
+        }
+    }
+
+    member_access_env->Add("this", Variable(optional_type_definition->value.object, Qualifier()));
+
+    return member_access_env;
+}
+
+FunctionObject *GetCaseMethod(Node *case_node, Value switch_value, Value case_value)
+{
+    if (switch_value.GetType() != case_value.GetType())
+    {
+        stringstream s;
+        s << "type '" << switch_value.GetType() << "' is not the same as '" << case_value.GetType() << "'";
+
+        throw ErrorObject(case_node->start, case_node->end, Error {TypeError, s.str()});
+    }
+
+    optional<Member> type_def = ((TypeDefinitionObject*)switch_value.GetType().type_definition.get())->GetMember("equality");
+
+    FunctionObject *operation_func = type_def ? ObjectCast<FunctionObject>(type_def->value.object.get()) : NULL;
+
+    if (!operation_func)
+    {
+        stringstream s;
+        s << "No method on type '" << switch_value.GetType() << "' for '==' with type '" << case_value.GetType() << "'";
+
+        throw ErrorObject(case_node->start, case_node->end, Error {OperationError, s.str() });
+    }
+
+    return operation_func;
+}
+
+bool GetCaseResult(Node *case_node, Value result, Value switch_value, Value case_value)
+{
+    if (result.tag != BoolValue)
+    {
+        stringstream s;
+        s << "Comparison of type '" << switch_value.GetType() << "' with type '" << case_value.GetType() << "' does not return a boolean";
+
+        throw ErrorObject(case_node->start, case_node->end, Error {OperationError, s.str() });
+    }
+
+    return result.bool_value;
+}
+
+
+bool IsAssignment(OPERATOR operator_code)
+{
+    return operator_code == AssignmentOperator || operator_code == AddAssignmentOperator || operator_code == SubtractAssignmentOperator || operator_code == MultiplyAssignmentOperator || operator_code == DivideAssignmentOperator;
+}
+
+void AssignValue(Node *target, Value value, shared_ptr<Environment> env, int depth, int slot)
+{
+    // Methods that return void (assignment defined on a class) have already updated the object themselves
+    if (value.tag == VoidValue)
+    {
+        return;
+    }
+
+    if (target->kind == GetVariableNode)
+    {
+        Variable *var = env->Find(((GetVariable*)target)->name, depth, slot);
+
+        if (var)
+        {
+            var->value = value;
+        }
+    }
+    else if (target->kind == MemberAccessNode && ((MemberAccess*)target)->statement->kind == GetVariableNode)
+    {
+        MemberAccess *member_access = (MemberAccess*)target;
+
+        Variable *var = env->Get(member_access->name);
+
+        ClassInstanceObject *object = var ? ObjectCast<ClassInstanceObject>(var->value.object.get()) : NULL;
+
+        int slot = object ? object->GetShape().Find(((GetVariable*)member_access->statement)->name) : -1;
+
+        if (slot != -1)
+        {
+            object->slots[slot].value = value;
+        }
+    }
+}
@@ -4,16 +4,71 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 
 #include "object.hpp"
 #include "node.hpp"
 
-std::pair<std::shared_ptr<Object>, RETURN_REASON> Interpret(std::vector<Node*> AST, std::shared_ptr<Environment> env, std::vector<Call> call_stack);
+std::pair<Value, RETURN_REASON> Interpret(const std::vector<Node*> &AST, const std::shared_ptr<Environment> &env, Call *call_stack);
 
-Type InterpretType(TypeExpression type_expression, std::shared_ptr<Environment> env);
+Value InterpretExpression(Node *node, const std::shared_ptr<Environment> &env, Call *call_stack);
 
-std::shared_ptr<FunctionObject> InterpretCodeBlock(CodeBlock code_block, std::shared_ptr<Environment> env);
+std::pair<Value, RETURN_REASON> InterpretStatement(Node *node, const std::shared_ptr<Environment> &env, Call *call_stack);
 
-std::shared_ptr<Object> CallFunction(FunctionObject *function, std::map<std::string, Variable> argument_values, std::shared_ptr<Environment> env, std::vector<Call> call_stack);
+Value InterpretOperation(Operation *operation, const std::shared_ptr<Environment> &env, Call *call_stack, int depth);
+
+Value ApplyOperation(Operation *operation, const Value &left, const Value &right, const std::shared_ptr<Environment> &env, Call *call_stack);
+
+Type InterpretType(TypeExpression &type_expression, const std::shared_ptr<Environment> &env);
+
+std::shared_ptr<FunctionObject> InterpretCodeBlock(CodeBlock *code_block, const std::shared_ptr<Environment> &env);
+
+std::vector<Variable> InterpretArguments(FunctionObject *function, Node *call, std::vector<Node*> arguments, std::shared_ptr<Environment> env, Call *call_stack);
+
+Value CallFunction(FunctionObject *function, std::vector<Variable> argument_values, std::optional<Value> self, std::shared_ptr<Environment> env, Node *call, Call *call_stack);
+
+std::vector<TraceFrame> GetStackTrace(Call *call_stack);
+
+std::string GetCallName(Node *call);
+
+bool IsConstantExpression(Node *expression);
+
+Value InterpretLiteral(Literal *literal);
+
+std::string GetOperatorMethodName(OPERATOR operator_code);
+
+FunctionObject *GetOperatorMethod(Operation *operation, const Value &left, const Value &right);
+
+bool GetCondition(Value value, Node *expression);
+
+void InterpretDeclaration(DeclareVariable *declare_variable, Value value, std::shared_ptr<Environment> env, int slot = -1);
+
+std::shared_ptr<Object> GetFunction(FunctionCall *function_call, std::shared_ptr<Environment> env, int depth = 0, int slot = -1);
+
+void CheckArgument(const Parameter &parameter, const Value &value, Node *argument);
+
+void ThrowTooFewArguments(FunctionObject *function, Node *call);
+
+void DefineClass(ClassDefinition *class_definition, std::shared_ptr<Environment> class_env, std::shared_ptr<Environment> env);
+
+std::shared_ptr<Object> GetClassDefinition(InstanceClass *instance_class, std::shared_ptr<Environment> env);
+
+FunctionObject *GetConstructor(InstanceClass *instance_class, TypeDefinitionObject *definition);
+
+std::shared_ptr<Environment> CreateConstructorEnvironment(TypeDefinitionObject *definition, std::shared_ptr<Object> instance, std::shared_ptr<Environment> env);
+
+Variable *GetInstanceVariable(MemberAccess *member_access, std::shared_ptr<Environment> env, int depth = 0, int slot = -1);
+
+Value GetMemberValue(MemberAccess *member_access, std::shared_ptr<Environment> env, int depth = 0, int slot = -1);
+
+std::shared_ptr<Environment> CreateMemberAccessEnvironment(MemberAccess *member_access, std::shared_ptr<Environment> env, int depth = 0, int slot = -1);
+
+FunctionObject *GetCaseMethod(Node *case_node, Value switch_value, Value case_value);
+
+bool GetCaseResult(Node *case_node, Value result, Value switch_value, Value case_value);
+
+bool IsAssignment(OPERATOR operator_code);
+
+void AssignValue(Node *target, Value value, std::shared_ptr<Environment> env, int depth = 0, int slot = -1);
 
 #endif
\ No newline at end of file
@@ -2,30 +2,113 @@
 #include <fstream>
 #include <string>
 #include <vector>
-#include <regex>
+#include <string_view>
+#include <charconv>
+#include <array>
 
 #include "lexer.hpp"
 #include "token.hpp"
 
 using namespace std;
 
+enum CHARACTER_CLASS
+{
+    DigitCharacter = 1,
+    HexDigitCharacter = 2,
+    IdentifierStartCharacter = 4,
+    IdentifierCharacter = 8,
+    WhiteSpaceCharacter = 16,
+    ControlCharacter = 32,
+    BracketCharacter = 64,
+    OperatorCharacter = 128,
+};
+
+constexpr array<unsigned char, 256> CreateCharacterClasses()
+{
+    array<unsigned char, 256> classes = {};
+
+    for (int c = '0'; c <= '9'; c++)
+    {
+        classes[c] |= DigitCharacter | HexDigitCharacter | IdentifierCharacter;
+    }
+
+    for (int c = 'a'; c <= 'z'; c++)
+    {
+        classes[c] |= IdentifierStartCharacter | IdentifierCharacter;
+        classes[c - 'a' + 'A'] |= IdentifierStartCharacter | IdentifierCharacter;
+    }
+
+    for (int c = 'a'; c <= 'f'; c++)
+    {
+        classes[c] |= HexDigitCharacter;
+        classes[c - 'a' + 'A'] |= HexDigitCharacter;
+    }
+
+    classes['_'] |= IdentifierStartCharacter | IdentifierCharacter;
+
+    for (char c : { ' ', '\t', '\f', '\r', '\n' })
+    {
+        classes[(unsigned char)c] |= WhiteSpaceCharacter;
+    }
+
+    for (char c : { '.', ',', ':', ';' })
+    {
+        classes[(unsigned char)c] |= ControlCharacter;
+    }
+
+    for (char c : { '(', ')', '[', ']', '{', '}' })
+    {
+        classes[(unsigned char)c] |= BracketCharacter;
+    }
+
+    for (char c : { '+', '-', '*', '/', '$', '%', '^', '=', '<', '>', '!', '&', '|' })
+    {
+        classes[(unsigned char)c] |= OperatorCharacter;
+    }
+
+    return classes;
+}
+
+constexpr array<unsigned char, 256> CharacterClasses = CreateCharacterClasses();
+
+// Indexed by KeywordHash, which has no collisions over Keywords, so a lookup is a single comparison
+constexpr array<string_view, 22> KeywordTable = {
+    "const", "", "", "switch", "return", "public", "case", "default", "break", "", "continue",
+    "for", "new", "if", "", "", "else", "", "", "while", "static", "class",
+};
+
+bool IsCharacter(char c, int character_class)
+{
+    return CharacterClasses[(unsigned char)c] & character_class;
+}
+
+int KeywordHash(string_view name)
+{
+    return (name.size() + 5 * (unsigned char)name.front() + (unsigned char)name.back()) % KeywordTable.size();
+}
+
+bool IsKeyword(string_view name)
+{
+    return KeywordTable[KeywordHash(name)] == name;
+}
+
+int CountCharacters(string_view text, int position, int character_class)
+{
+    int length = 0;
+
+    while (position + length < text.size() && IsCharacter(text[position + length], character_class))
+    {
+        length++;
+    }
+
+    return length;
+}
+
 vector<Token*> Tokenise(string text)
 {
     vector<Token*> tokens = vector<Token*>();
 
-    regex re_string_start = regex("^([\"']|(```))");
-    regex re_white_space = regex("^[ \t\f\r\n]");
-    regex re_integer = regex("^((0[box][0-9A-Fa-f]+)|([0-9]+))");
-    regex re_float = regex("^(([0-9]+\\.[0-9]*)|([0-9]*\\.[0-9]+))");
-    regex re_bool = regex("^((false)|(true))");
-    regex re_identifier = regex("^([a-zA-Z_][a-zA-Z0-9_]*)");
-    regex re_control = regex("^[.,:;]");
-    regex re_bracket = regex("^[\\(\\)\\[\\]\\{\\}]");
-    regex re_operator = regex("^(([=!<>\\+\\-\\*\\/]=)|[\\+\\-\\*\\/\\$%\\^=<>!&\\|])");
-    regex re_comment_start = regex("^(/[/\\*])");
-    regex re_comment_end = regex("^(\\*/)");
-
-    smatch m;
+    string_view source = text;
 
     int current_char = 0;
     bool escaping = false;
@@ -38,19 +121,29 @@ vector<Token*> Tokenise(string text)
     bool multiline_comment = false;
     int comment_start = 0;
 
-    while (text != "")
+    // Reads past the end give '\0', which matches no character class
+    auto peek = [&](int offset) -> char
+    {
+        return current_char + offset < source.size() ? source[current_char + offset] : '\0';
+    };
+
+    while (current_char < source.size())
     {
+        char current = source[current_char];
+
+        bool last_line_break = current == '\n' && current_char == source.size() - 1;
+
         if (currently_string)
         {
-            if (string_start == '`' && text != "\n" && text[0] != '`')
+            if (string_start == '`' && !last_line_break && current != '`')
             {
-                string_token->content.append({text[0]});
+                string_token->content.push_back(current);
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
 
                 continue;
             }
-            else if (text[0] == '\n' && !escaping)
+            else if (current == '\n' && !escaping)
             {
                 string_token->error = Error {SyntaxError, "Unterminated string literal"};
 
@@ -58,13 +151,13 @@ vector<Token*> Tokenise(string text)
 
                 return vector<Token*> { string_token };
             }
-            else if (text[0] == string_start && !escaping)
+            else if (current == string_start && !escaping)
             {
-                if (string_start == '`' && !(text.size() >= 3 && text[1] == '`' && text[2] == '`'))
+                if (string_start == '`' && !(peek(1) == '`' && peek(2) == '`'))
                 {
-                    string_token->content.append({text[0]});
+                    string_token->content.push_back(current);
 
-                    EraseFront(&text, &current_char, 1);
+                    current_char++;
                 }
                 else
                 {
@@ -74,30 +167,22 @@ vector<Token*> Tokenise(string text)
                     
                     tokens.push_back(string_token);
 
-                    if (string_start == '`')
-                    {
-                        EraseFront(&text, &current_char, 3);
-                    }
-                    else
-                    {
-                        EraseFront(&text, &current_char, 1);
-                    }
+                    current_char += string_start == '`' ? 3 : 1;
                 }
             }
             else if (escaping)
             {
-                string_token->content.append({text[0]});
+                string_token->content.push_back(current);
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
 
                 escaping = false;
-
             }
-            else if (text[0] == '\\')
+            else if (current == '\\')
             {
-                EraseFront(&text, &current_char, 1);
+                current_char++;
 
-                switch (text[0]) {
+                switch (peek(0)) {
                     case 'a':
                         string_token->content.append("\a");
                         break;
@@ -120,48 +205,48 @@ vector<Token*> Tokenise(string text)
                         string_token->content.append("\v");
                         break;
                     default:
-                        smatch escape_m;
-
-                        regex re_octal = regex("^[0-3][0-7]{0,2}");
-                        regex re_hex = regex("^x[0-9a-fA-F]{2}");
-                        regex re_hex_16 = regex("^u[0-9a-fA-F]{4}");
-                        regex re_hex_32 = regex("^u[0-9a-fA-F]{8}");
-
-                        if (regex_search(text, escape_m, re_octal))
+                        if (peek(0) >= '0' && peek(0) <= '3')
                         {
-                            string_token->content.append({(char)stoi(escape_m[0], 0, 8)});
+                            int length = 1;
 
-                            EraseFront(&text, &current_char, escape_m.length());
+                            while (length < 3 && peek(length) >= '0' && peek(length) <= '7')
+                            {
+                                length++;
+                            }
 
-                            continue;
-                        }
-                        else if (regex_search(text, escape_m, re_hex))
-                        {
-                            string number = ((string)escape_m[0]).substr(1);
+                            int number = 0;
+
+                            from_chars(source.data() + current_char, source.data() + current_char + length, number, 8);
 
-                            string_token->content.append({(char)stoi(number, 0, 16)});
+                            string_token->content.push_back((char)number);
 
-                            EraseFront(&text, &current_char, 3);
+                            current_char += length;
 
                             continue;
                         }
-                        else if (regex_search(text, escape_m, re_hex_32))
+                        else if (peek(0) == 'x' && CountCharacters(source, current_char + 1, HexDigitCharacter) >= 2)
                         {
-                            string number = ((string)escape_m[0]).substr(1);
+                            int number = 0;
 
-                            string_token->content.append(UnicodeToUTF8(stol(number, 0, 16)));
+                            from_chars(source.data() + current_char + 1, source.data() + current_char + 3, number, 16);
 
-                            EraseFront(&text, &current_char, 9);
+                            string_token->content.push_back((char)number);
+
+                            current_char += 3;
 
                             continue;
                         }
-                        else if (regex_search(text, escape_m, re_hex_16))
+                        else if (peek(0) == 'u' && CountCharacters(source, current_char + 1, HexDigitCharacter) >= 4)
                         {
-                            string number = ((string)escape_m[0]).substr(1);
+                            int length = CountCharacters(source, current_char + 1, HexDigitCharacter) >= 8 ? 8 : 4;
+
+                            unsigned int number = 0;
 
-                            string_token->content.append(UnicodeToUTF8(stol(number, 0, 16)));
+                            from_chars(source.data() + current_char + 1, source.data() + current_char + 1 + length, number, 16);
 
-                            EraseFront(&text, &current_char, 5);
+                            string_token->content.append(UnicodeToUTF8(number));
+
+                            current_char += length + 1;
 
                             continue;
                         }
@@ -173,18 +258,18 @@ vector<Token*> Tokenise(string text)
                         }
                 }
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
             else
             {
-                string_token->content.append({text[0]});
+                string_token->content.push_back(current);
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
         }
         else if (currently_comment)
         {
-            if (multiline_comment && text == "\n")
+            if (multiline_comment && last_line_break)
             {
                 Token *t = new Token();
 
@@ -196,263 +281,256 @@ vector<Token*> Tokenise(string text)
 
                 return vector<Token*> { t };
             }
-            if (!multiline_comment && text[0] == '\n' && !escaping)
+            if (!multiline_comment && current == '\n' && !escaping)
             {
                 currently_comment = false;
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
-            else if (multiline_comment && regex_search(text, re_comment_end) && !escaping)
+            else if (multiline_comment && current == '*' && peek(1) == '/' && !escaping)
             {
                 currently_comment = false;
 
-                EraseFront(&text, &current_char, 2);
+                current_char += 2;
             }
             else if (escaping)
             {
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
-            else if (text[0] == '\\')
+            else if (current == '\\')
             {
                 escaping = true;
 
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
             else
             {
-                EraseFront(&text, &current_char, 1);
+                current_char++;
             }
         }
-        else if (regex_search(text, m, re_string_start))
+        else if (current == '"' || current == '\'' || (current == '`' && peek(1) == '`' && peek(2) == '`'))
         {
             currently_string = true;
 
-            string_start = ((string)m[0])[0];
+            string_start = current;
 
             string_token = new String("");
 
             string_token->start = current_char;
 
-            EraseFront(&text, &current_char, m[0].length());
+            current_char += current == '`' ? 3 : 1;
         }
-        else if (regex_search(text, m, re_comment_start))
+        else if (current == '/' && (peek(1) == '/' || peek(1) == '*'))
         {
             currently_comment = true;
 
             comment_start = current_char;
 
-            if (m[0] == "//")
-            {
-                multiline_comment = false;
-            }
-            else
-            {
-                multiline_comment = true;
-            }
+            multiline_comment = peek(1) == '*';
 
-            EraseFront(&text, &current_char, 2);
+            current_char += 2;
         }
-        else if (regex_search(text, m, re_white_space))
+        else if (IsCharacter(current, WhiteSpaceCharacter))
         {
-            EraseFront(&text, &current_char, m.length());
+            current_char++;
         }
-        else if (regex_search(text, m, re_float))
+        else if (IsCharacter(current, DigitCharacter) || current == '.')
         {
-            Float *new_float;
+            int integer_length = CountCharacters(source, current_char, DigitCharacter);
+            int fraction_length = peek(integer_length) == '.' ? CountCharacters(source, current_char + integer_length + 1, DigitCharacter) : -1;
 
-            try
-            {
-                new_float = new Float(stod(m[0]));
-            }
-            catch (out_of_range)
+            const char *number_start = source.data() + current_char;
+
+            // A float needs a point, and digits on at least one side of it
+            if (fraction_length >= 0 && integer_length + fraction_length > 0)
             {
-                Token *t = new Token();
+                int length = integer_length + 1 + fraction_length;
 
-                t->error = Error {SyntaxError, "Float too large or too small"};
+                double number = 0;
 
-                t->start = comment_start;
+                if (from_chars(number_start, number_start + length, number).ec == errc::result_out_of_range)
+                {
+                    Token *t = new Token();
 
-                t->end = current_char;
+                    t->error = Error {SyntaxError, "Float too large or too small"};
 
-                return vector<Token*> { t };
+                    t->start = comment_start;
+
+                    t->end = current_char;
+
+                    return vector<Token*> { t };
+                }
+
+                Float *new_float = new Float(number);
+
+                new_float->start = current_char;
+                new_float->end = current_char + length;
+
+                tokens.push_back(new_float);
+
+                current_char += length;
+
+                continue;
             }
+            else if (integer_length == 0)
+            {
+                Control *new_control = new Control(".");
 
-            new_float->start = current_char;
-            new_float->end = current_char + m.length();
+                new_control->start = current_char;
+                new_control->end = current_char + 1;
 
-            tokens.push_back(new_float);
+                tokens.push_back(new_control);
 
-            EraseFront(&text, &current_char, m.length());
-        }
-        else if (regex_search(text, m, re_integer))
-        {
-            int length = m[0].length();
+                current_char++;
 
-            string string_value = m[0];
+                continue;
+            }
 
-            int value = 0;
+            int length = integer_length;
+            int base = 10;
+            string base_name;
 
-            if (string_value[0] == '0' && string_value.size() != 0)
+            if (current == '0' && IsCharacter(peek(2), HexDigitCharacter))
             {
-                if (string_value[1] == 'b')
-                {
-                    string_value.erase(0, 2);
-
-                    try
-                    {
-                        value = stoi(string_value, 0, 2);
-                    }
-                    catch (invalid_argument)
-                    {
-                        Token *t = new Token();
-
-                        t->error = Error {SyntaxError, "Invalid character in binary integer"};
-                        t->start = current_char;
-                        t->end = current_char + length;
-
-                        return vector<Token*> { t };
-                    }
-                }
-                else if (string_value[1] == 'o')
-                {
-                    string_value.erase(0, 2);
-
-                    try
-                    {
-                        value = stoi(string_value, 0, 8);
-                    }
-                    catch (invalid_argument)
-                    {
-                        Token *t = new Token();
-
-                        t->error = Error {SyntaxError, "Invalid character in octal integer"};
-                        t->start = current_char;
-                        t->end = current_char + length;
-
-                        return vector<Token*> { t };
-                    }
-                }
-                else if (string_value[1] == 'x')
+                switch (peek(1))
                 {
-                    string_value.erase(0, 2);
-
-                    try
-                    {
-                        value = stoi(string_value, 0, 16);
-                    }
-                    catch (invalid_argument)
-                    {
-                        Token *t = new Token();
-
-                        t->error = Error {SyntaxError, "Invalid character in hexadecimal integer"};
-                        t->start = current_char;
-                        t->end = current_char + length;
-
-                        return vector<Token*> { t };
-                    }
+                    case 'b':
+                        base = 2;
+                        base_name = "binary";
+                        break;
+                    case 'o':
+                        base = 8;
+                        base_name = "octal";
+                        break;
+                    case 'x':
+                        base = 16;
+                        base_name = "hexadecimal";
+                        break;
                 }
-                else
+            }
+
+            int value = 0;
+            from_chars_result result;
+
+            if (base != 10)
+            {
+                length = 2 + CountCharacters(source, current_char + 2, HexDigitCharacter);
+
+                // Like the digits of the literal, parsing stops at the first character outside the base
+                result = from_chars(number_start + 2, number_start + length, value, base);
+
+                if (result.ec == errc::invalid_argument)
                 {
-                    value = stoi(string_value);
+                    Token *t = new Token();
+
+                    t->error = Error {SyntaxError, "Invalid character in " + base_name + " integer"};
+                    t->start = current_char;
+                    t->end = current_char + length;
+
+                    return vector<Token*> { t };
                 }
             }
             else
             {
-                try
-                {
-                    value = stoi(string_value);
-                }
-                catch (out_of_range)
-                {
-                    Token *t = new Token();
+                result = from_chars(number_start, number_start + length, value);
+            }
 
-                    t->error = Error {SyntaxError, "Integer too large or too small"};
+            if (result.ec == errc::result_out_of_range)
+            {
+                Token *t = new Token();
 
-                    t->start = comment_start;
+                t->error = Error {SyntaxError, "Integer too large or too small"};
 
-                    t->end = current_char;
+                t->start = comment_start;
 
-                    return vector<Token*> { t };
-                }
+                t->end = current_char;
+
+                return vector<Token*> { t };
             }
 
             Integer *new_integer = new Integer(value);
 
             new_integer->start = current_char;
-            new_integer->end = current_char + m.length();
+            new_integer->end = current_char + length;
 
             tokens.push_back(new_integer);
 
-            EraseFront(&text, &current_char, m.length());
+            current_char += length;
         }
-        else if (regex_search(text, m, re_bool))
+        else if (source.compare(current_char, 4, "true") == 0 || source.compare(current_char, 5, "false") == 0)
         {
-            Boolean *new_boolean = new Boolean(m[0] == "true" ? true : false);
+            // Booleans are matched before identifiers, so "trueish" is read as true followed by "ish"
+            bool value = current == 't';
+
+            int length = value ? 4 : 5;
+
+            Boolean *new_boolean = new Boolean(value);
 
             new_boolean->start = current_char;
-            new_boolean->end = current_char + m.length();
+            new_boolean->end = current_char + length;
 
             tokens.push_back(new_boolean);
 
-            EraseFront(&text, &current_char, m.length());
+            current_char += length;
         }
-        else if (regex_search(text, m, re_identifier))
+        else if (IsCharacter(current, IdentifierStartCharacter))
         {
-            if (find(begin(Keywords), end(Keywords), m[0]) != end(Keywords))
-            {
-                Keyword *new_keyword = new Keyword(m[0]);
+            int length = CountCharacters(source, current_char, IdentifierCharacter);
 
-                new_keyword->start = current_char;
-                new_keyword->end = current_char + m.length();
+            string_view name = source.substr(current_char, length);
 
-                tokens.push_back(new_keyword);
+            Token *new_token;
 
-                EraseFront(&text, &current_char, m.length());
+            if (IsKeyword(name))
+            {
+                new_token = new Keyword(string(name));
             }
             else
             {
-                Identifier *new_identifier = new Identifier(m[0]);
+                new_token = new Identifier(string(name));
+            }
 
-                new_identifier->start = current_char;
-                new_identifier->end = current_char + m.length();
+            new_token->start = current_char;
+            new_token->end = current_char + length;
 
-                tokens.push_back(new_identifier);
+            tokens.push_back(new_token);
 
-                EraseFront(&text, &current_char, m.length());
-            }
+            current_char += length;
         }
-        else if (regex_search(text, m, re_control))
+        else if (IsCharacter(current, ControlCharacter))
         {
-            Control *new_control = new Control(m[0]);
+            Control *new_control = new Control(string(1, current));
 
             new_control->start = current_char;
-            new_control->end = current_char + m.length();
+            new_control->end = current_char + 1;
 
             tokens.push_back(new_control);
 
-            EraseFront(&text, &current_char, m.length());
+            current_char++;
         }
-        else if (regex_search(text, m, re_bracket))
+        else if (IsCharacter(current, BracketCharacter))
         {
-            Bracket *new_bracket = new Bracket(m[0]);
+            Bracket *new_bracket = new Bracket(string(1, current));
 
             new_bracket->start = current_char;
-            new_bracket->end = current_char + m.length();
+            new_bracket->end = current_char + 1;
 
             tokens.push_back(new_bracket);
 
-            EraseFront(&text, &current_char, m.length());
+            current_char++;
         }
-        else if (regex_search(text, m, re_operator))
+        else if (IsCharacter(current, OperatorCharacter))
         {
-            Operator *new_operator = new Operator(m[0]);
+            int length = peek(1) == '=' && string_view("=!<>+-*/").find(current) != string_view::npos ? 2 : 1;
+
+            Operator *new_operator = new Operator(string(source.substr(current_char, length)));
 
             new_operator->start = current_char;
-            new_operator->end = current_char + m.length();
+            new_operator->end = current_char + length;
 
             tokens.push_back(new_operator);
 
-            EraseFront(&text, &current_char, m.length());
+            current_char += length;
         }
         else
         {
@@ -495,11 +573,4 @@ string UnicodeToUTF8(unsigned int codepoint)
         out.append(1, static_cast<char>(0x80 | (codepoint & 0x3f)));
     }
     return out;
-}
-
-void EraseFront(string *text, int *current, int length)
-{
-    text->erase(0, length);
-
-    *current += length;
 }
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include <fstream>
 #include <string>
 #include <vector>
-#include <regex>
 
 #include "token.hpp"
 
@@ -13,6 +12,4 @@ std::vector<Token*> Tokenise(std::string text);
 
 std::string UnicodeToUTF8(unsigned int codepoint);
 
-void EraseFront(std::string *text, int *current, int length);
-
 #endif
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "../syntax_analyser.hpp"
 #include "../semantics_analyser.hpp"
 #include "../interpreter.hpp"
+#include "../compiler.hpp"
+#include "../vm.hpp"
 #include "../token.hpp"
 #include "../node.hpp"
 #include "../object.hpp"
@@ -17,19 +19,11 @@
 
 using namespace std;
 
-int main(int argc, char *argv[])
+// Runs the program in file_name, from tokenising to printing the result
+int Run(string file_name, bool tree_walk, bool gc_stats)
 {
-    if (argc < 2)
-    {
-        cout << "\033[1;31mError:\033[0;31m No input file provided\033[m\n";
-
-        cout << "\033[30mCompilation Terminated.\033[m\n";
-
-        return 1;
-    }
-
     fstream f;
-    f.open(argv[1], ios::in);
+    f.open(file_name, ios::in);
 
     vector<int> line_numbers = vector<int>();
 
@@ -53,11 +47,14 @@ int main(int argc, char *argv[])
         return ThrowError(*tokens[0]->error, tokens[0]->start, tokens[0]->end, line_numbers, lines);
     }
 
+    // Every node of the program lives in this arena and is released when main returns
+    NodeArena arena;
+
     vector<Node*> AST;
 
     try
     {
-        AST = get<0>(AnalyseSyntax(tokens));
+        AST = get<0>(AnalyseSyntax(tokens, arena));
     }
     catch (Node *node)
     {
@@ -75,24 +72,97 @@ int main(int argc, char *argv[])
     
     shared_ptr<Environment> env = InitialiseInterpreterData();
 
-    shared_ptr<Object> result;
+    Value result;
 
     try
     {
-        result = get<0>(Interpret(AST, env, {}));
+        if (tree_walk)
+        {
+            result = get<0>(Interpret(AST, env, {}));
+        }
+        else
+        {
+            result = Execute(Compile(AST), env);
+        }
     }
     catch (ErrorObject error)
     {
-        return ThrowError(error.error, error.start, error.end, line_numbers, lines);
+        return ThrowError(error.error, error.start, error.end, line_numbers, lines, error.stack_trace);
     }
 
 
     cout << "\nEnvironment:\n" << *env << "\n\n";
     
-    if (result)
+    cout << "Return Value: " << result;
+
+    if (gc_stats)
     {
-        cout << "Return Value: " << *result;
+        cout << "\n\n" << DefaultHeap << "\n" << DefaultAllocator;
     }
 
     return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    string file_name;
+
+    // The bytecode virtual machine is the default, the tree-walking interpreter is kept as a reference
+    bool tree_walk = false;
+
+    bool gc_stats = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string argument = argv[i];
+
+        if (argument == "--tree-walk")
+        {
+            tree_walk = true;
+        }
+        else if (argument == "--gc-stats")
+        {
+            gc_stats = true;
+        }
+        else if (argument.rfind("--max-depth=", 0) == 0)
+        {
+            string depth = argument.substr(12);
+
+            if (depth.empty() || depth.size() > 9 || depth.find_first_not_of("0123456789") != string::npos)
+            {
+                cout << "\033[1;31mError:\033[0;31m Invalid maximum depth '" << depth << "'\033[m\n";
+
+                cout << "\033[30mCompilation Terminated.\033[m\n";
+
+                return 1;
+            }
+
+            Max_Call_Depth = stoi(depth);
+        }
+        else if (argument.rfind("--", 0) == 0)
+        {
+            cout << "\033[1;31mError:\033[0;31m Unknown option '" << argument << "'\033[m\n";
+
+            cout << "\033[30mCompilation Terminated.\033[m\n";
+
+            return 1;
+        }
+        else
+        {
+            file_name = argument;
+        }
+    }
+
+    if (file_name.empty())
+    {
+        cout << "\033[1;31mError:\033[0;31m No input file provided\033[m\n";
+
+        cout << "\033[30mCompilation Terminated.\033[m\n";
+
+        return 1;
+    }
+
+    // Interpreted calls recurse on the native stack in the tree-walker, so it runs on a stack sized for --max-depth.
+    // The virtual machine keeps its frames on the heap and only needs the usual stack for nesting.
+    return RunWithCallStack(tree_walk ? Max_Call_Depth : 0, [&]() { return Run(file_name, tree_walk, gc_stats); });
 }
\ No newline at end of file
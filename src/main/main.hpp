@@ -3,6 +3,8 @@
 
 #include <string>
 
+int Run(std::string file_name, bool tree_walk, bool gc_stats);
+
 int main(int argc, char *argv[]);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <tuple>
 #include <optional>
 #include <vector>
+#include <string_view>
 
 #include "node.hpp"
 #include "error.hpp"
@@ -10,7 +11,43 @@
 
 using namespace std;
 
-vector<string> Operator_Preference = { "^[\\^]$", "^[\\*\\/\\$\\%]$", "^[\\+\\-]$", "^[<>]|([!=<>]=)$", "^&$", "^\\|$", "^[\\+\\-\\*\\/]?=$" };
+constexpr pair<string_view, OPERATOR> Unary_Operators[] = {
+    { "!", NotOperator }, { "-", NegativeOperator }, { "+", PositiveOperator },
+};
+
+constexpr pair<string_view, OPERATOR> Binary_Operators[] = {
+    { "^", PowOperator }, { "*", MultiplyOperator }, { "/", DivideOperator }, { "$", IntDivideOperator }, { "%", ModuloOperator },
+    { "+", AddOperator }, { "-", SubtractOperator },
+    { "==", EqualityOperator }, { "!=", InequalityOperator }, { ">=", GreaterEqualOperator }, { "<=", LessEqualOperator }, { ">", GreaterOperator }, { "<", LessOperator },
+    { "&", AndOperator }, { "|", OrOperator },
+    { "=", AssignmentOperator }, { "+=", AddAssignmentOperator }, { "-=", SubtractAssignmentOperator }, { "*=", MultiplyAssignmentOperator }, { "/=", DivideAssignmentOperator },
+};
+
+OPERATOR GetOperator(string operator_string, bool unary)
+{
+    if (unary)
+    {
+        for (auto [symbol, code] : Unary_Operators)
+        {
+            if (symbol == operator_string)
+            {
+                return code;
+            }
+        }
+
+        return UnknownOperator;
+    }
+
+    for (auto [symbol, code] : Binary_Operators)
+    {
+        if (symbol == operator_string)
+        {
+            return code;
+        }
+    }
+
+    return UnknownOperator;
+}
 
 void ThrowError(int start, int end, Error error)
 {
@@ -25,158 +62,115 @@ void ThrowError(int start, int end, Error error)
 
 Node::Node()
 {
-    this->type = "";
+    this->kind = EmptyNode;
+}
+
+Node::~Node()
+{
+
 }
 
 void Node::CheckSemantics(vector<Node*> call_stack)
 {
-    if (this->type == "CodeBlock")
-    {
-        ((CodeBlock*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "Operation")
-    {
-        ((Operation*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "DeclareVariable")
-    {
-        ((DeclareVariable*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "FunctionCall")
-    {
-        ((FunctionCall*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "ClassDefinition")
-    {
-        ((ClassDefinition*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "InstanceClass")
-    {
-        ((InstanceClass*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "MemberAccess")
-    {
-        ((MemberAccess*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "IfStatement")
-    {
-        ((IfStatement*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "SwitchStatement")
-    {
-        ((SwitchStatement*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "ForLoop")
-    {
-        ((ForLoop*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "ForEachLoop")
-    {
-        ((ForEachLoop*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "WhileLoop")
-    {
-        ((WhileLoop*)this)->CheckSemantics(call_stack);
-    }
-    else if (this->type == "Return")
-    {
-        ((Return*)this)->CheckSemantics(call_stack);
-    }
+
 }
 
 ostream &operator<<(ostream &os, const Node &n)
 {
-    if (n.type == "TypeExpression")
+    switch (n.kind)
     {
-        return os << (TypeExpression&)n;
-    }
-    else if (n.type == "ParameterExpression")
-    {
-        return os << (ParameterExpression&)n;
-    }
-    else if (n.type == "QualifierExpression")
-    {
-        return os << (QualifierExpression&)n;
-    }
-    else if (n.type == "Literal")
-    {
-        return os << (Literal&)n;
-    }
-    else if (n.type == "CodeBlock")
-    {
-        return os << (CodeBlock&)n;
-    }
-    else if (n.type == "Operation")
-    {
-        return os << (Operation&)n;
-    }
-    else if (n.type == "GetVariable")
-    {
-        return os << (GetVariable&)n;
-    }
-    else if (n.type == "DeclareVariable")
-    {
-        return os << (DeclareVariable&)n;
-    }
-    else if (n.type == "FunctionCall")
-    {
-        return os << (FunctionCall&)n;
-    }
-    else if (n.type == "ClassDefinition")
-    {
-        return os << (ClassDefinition&)n;
-    }
-    else if (n.type == "InstanceClass")
-    {
-        return os << (InstanceClass&)n;
-    }
-    else if (n.type == "MemberAccess")
-    {
-        return os << (MemberAccess&)n;
-    }
-    else if (n.type == "IfStatement")
-    {
-        return os << (IfStatement&)n;
-    }
-    else if (n.type == "SwitchStatement")
-    {
-        return os << (SwitchStatement&)n;
-    }
-    else if (n.type == "ForLoop")
-    {
-        return os << (ForLoop&)n;
-    }
-    else if (n.type == "ForEachLoop")
-    {
-        return os << (ForEachLoop&)n;
-    }
-    else if (n.type == "WhileLoop")
-    {
-        return os << (WhileLoop&)n;
-    }
-    else if (n.type == "Return")
-    {
-        return os << (Return&)n;
-    }
-    else if (n.type == "Break")
-    {
-        return os << (Break&)n;
-    }
-    else if (n.type == "Continue")
-    {
-        return os << (Continue&)n;
-    }
-    else if (n.type == "StatementEnd")
-    {
-        return os << (StatementEnd&)n;
+        case TypeExpressionNode:
+        {
+            return os << (TypeExpression&)n;
+        }
+        case ParameterExpressionNode:
+        {
+            return os << (ParameterExpression&)n;
+        }
+        case QualifierExpressionNode:
+        {
+            return os << (QualifierExpression&)n;
+        }
+        case LiteralNode:
+        {
+            return os << (Literal&)n;
+        }
+        case CodeBlockNode:
+        {
+            return os << (CodeBlock&)n;
+        }
+        case OperationNode:
+        {
+            return os << (Operation&)n;
+        }
+        case GetVariableNode:
+        {
+            return os << (GetVariable&)n;
+        }
+        case DeclareVariableNode:
+        {
+            return os << (DeclareVariable&)n;
+        }
+        case FunctionCallNode:
+        {
+            return os << (FunctionCall&)n;
+        }
+        case ClassDefinitionNode:
+        {
+            return os << (ClassDefinition&)n;
+        }
+        case InstanceClassNode:
+        {
+            return os << (InstanceClass&)n;
+        }
+        case MemberAccessNode:
+        {
+            return os << (MemberAccess&)n;
+        }
+        case IfStatementNode:
+        {
+            return os << (IfStatement&)n;
+        }
+        case SwitchStatementNode:
+        {
+            return os << (SwitchStatement&)n;
+        }
+        case ForLoopNode:
+        {
+            return os << (ForLoop&)n;
+        }
+        case ForEachLoopNode:
+        {
+            return os << (ForEachLoop&)n;
+        }
+        case WhileLoopNode:
+        {
+            return os << (WhileLoop&)n;
+        }
+        case ReturnNode:
+        {
+            return os << (Return&)n;
+        }
+        case BreakNode:
+        {
+            return os << (Break&)n;
+        }
+        case ContinueNode:
+        {
+            return os << (Continue&)n;
+        }
+        case StatementEndNode:
+        {
+            return os << (StatementEnd&)n;
+        }
     }
     
     return os;
 }
 
-TypeExpression::TypeExpression(string name, bool is_array, vector<TypeExpression> content) : name(name), is_array(is_array), content(content)
+TypeExpression::TypeExpression(string name, bool is_array, vector<TypeExpression> content) : name(name), is_array(is_array), content(content), cached_generation(-1)
 {
-    this->type = "TypeExpression";
+    this->kind = TypeExpressionNode;
 }
 
 ostream &operator<<(ostream &os, const TypeExpression &data)
@@ -202,7 +196,7 @@ ostream &operator<<(ostream &os, const TypeExpression &data)
 
 ParameterExpression::ParameterExpression(TypeExpression type_data, string name, optional<Node*> default_argument, ARGUMENT_EXPANSION argument_expansion) : type_data(type_data), name(name), default_argument(default_argument), argument_expansion(argument_expansion)
 {
-    this->type = "ParameterExpression";
+    this->kind = ParameterExpressionNode;
 }
 
 ostream &operator<<(ostream &os, const ParameterExpression &data)
@@ -230,7 +224,7 @@ ostream &operator<<(ostream &os, const ParameterExpression &data)
 
 QualifierExpression::QualifierExpression(vector<string> qualifiers) : qualifiers(qualifiers)
 {
-    this->type = "QualifierExpression";
+    this->kind = QualifierExpressionNode;
 }
 
 bool QualifierExpression::Contains(string qualifier)
@@ -258,7 +252,7 @@ ostream &operator<<(ostream &os, const QualifierExpression &data)
 
 Literal::Literal()
 {
-    this->type = "Literal";
+    this->kind = LiteralNode;
 }
 
 ostream &operator<<(ostream &os, const Literal &data)
@@ -283,9 +277,9 @@ ostream &operator<<(ostream &os, const Literal &data)
     return os;
 }
 
-CodeBlock::CodeBlock(TypeExpression return_type, vector<ParameterExpression> parameters, vector<Node*> content) : return_type(return_type), parameters(parameters), content(content)
+CodeBlock::CodeBlock(TypeExpression return_type, vector<ParameterExpression> parameters, vector<Node*> content) : return_type(return_type), parameters(parameters), content(content), declares(true)
 {
-    this->type = "CodeBlock";
+    this->kind = CodeBlockNode;
 }
 
 void CodeBlock::CheckSemantics(vector<Node*> call_stack)
@@ -317,15 +311,63 @@ ostream &operator<<(ostream &os, const CodeBlock &data)
     return os;
 }
 
-Operation::Operation(string operator_string, Node *left, Node *right) : operator_string(operator_string), left(left), right(right)
+InlineCache::InlineCache() : size(0)
+{
+
+}
+
+Object *InlineCache::Find(Object *type)
+{
+    for (int i = 0; i < size; i++)
+    {
+        if (types[i].get() == type)
+        {
+            return methods[i].get();
+        }
+    }
+
+    return NULL;
+}
+
+void InlineCache::Add(shared_ptr<Object> type, shared_ptr<Object> method)
+{
+    // Sites that see more types than the cache holds keep using the full lookup for the extra types
+    if (size == Capacity)
+    {
+        return;
+    }
+
+    types[size] = type;
+    methods[size] = method;
+
+    size++;
+}
+
+Operation::Operation(string operator_string, Node *left, Node *right) : operator_string(operator_string), operator_code(GetOperator(operator_string, left == NULL)), left(left), right(right)
 {
-    this->type = "Operation";
+    this->kind = OperationNode;
 }
 
 void Operation::CheckSemantics(vector<Node*> call_stack)
 {
-    CheckExpression(this->left, call_stack);
-    CheckExpression(this->right, call_stack);
+    // Chains of operators are walked on an explicit stack, so their length only costs heap memory
+    vector<Node*> pending = {this->right, this->left};
+
+    while (pending.size() != 0)
+    {
+        Node *node = pending.back();
+        pending.pop_back();
+
+        if (node != NULL && node->kind == OperationNode)
+        {
+            pending.push_back(((Operation*)node)->right);
+            pending.push_back(((Operation*)node)->left);
+        }
+        else if (node != NULL)
+        {
+            CheckExpression(node, call_stack);
+        }
+    }
 }
 
 ostream &operator<<(ostream &os, const Operation &data)
@@ -342,7 +384,7 @@ ostream &operator<<(ostream &os, const Operation &data)
 
 GetVariable::GetVariable(string name) : name(name)
 {
-    this->type = "GetVariable";
+    this->kind = GetVariableNode;
 }
 
 ostream &operator<<(ostream &os, const GetVariable &data)
@@ -352,11 +394,16 @@ ostream &operator<<(ostream &os, const GetVariable &data)
 
 DeclareVariable::DeclareVariable(QualifierExpression *qualifier, TypeExpression variable_type, string name, Node *value) : qualifier(qualifier), variable_type(variable_type), name(name), value(value)
 {
-    this->type = "DeclareVariable";
+    this->kind = DeclareVariableNode;
 }
 
 void DeclareVariable::CheckSemantics(vector<Node*> call_stack)
 {
+    if (value != NULL && value->kind == CodeBlockNode)
+    {
+        ((CodeBlock*)value)->function_name = name;
+    }
+
     CheckExpression(value, call_stack);
 }
 
@@ -374,7 +421,7 @@ ostream &operator<<(ostream &os, const DeclareVariable &data)
 
 FunctionCall::FunctionCall(string name, vector<Node*> arguments) : name(name), arguments(arguments)
 {
-    this->type = "FunctionCall";
+    this->kind = FunctionCallNode;
 }
 
 void FunctionCall::CheckSemantics(vector<Node*> call_stack)
@@ -399,7 +446,7 @@ ostream &operator<<(ostream &os, const FunctionCall &data)
 
 ClassDefinition::ClassDefinition(string name, string interface, vector<Node*> body) : name(name), interface(interface), body(body)
 {
-    this->type = "ClassDefinition";
+    this->kind = ClassDefinitionNode;
 }
 
 void ClassDefinition::CheckSemantics(vector<Node*> call_stack)
@@ -433,7 +480,7 @@ ostream &operator<<(ostream &os, const ClassDefinition &data)
 
 InstanceClass::InstanceClass(string name, vector<Node*> arguments) : name(name), arguments(arguments)
 {
-    this->type = "InstanceClass";
+    this->kind = InstanceClassNode;
 }
 
 void InstanceClass::CheckSemantics(vector<Node*> call_stack)
@@ -456,9 +503,9 @@ ostream &operator<<(ostream &os, const InstanceClass &data)
     return os << ")";
 }
 
-MemberAccess::MemberAccess(string name, Node *statement) : name(name), statement(statement)
+MemberAccess::MemberAccess(string name, Node *statement) : name(name), statement(statement), cached_slot(-1)
 {
-    this->type = "MemberAccess";
+    this->kind = MemberAccessNode;
 }
 
 void MemberAccess::CheckSemantics(vector<Node*> call_stack)
@@ -473,7 +520,7 @@ ostream &operator<<(ostream &os, const MemberAccess &data)
 
 IfStatement::IfStatement(Node *if_expression, CodeBlock *if_code_block, vector<Node*> else_if_expressions, vector<CodeBlock*> else_if_code_blocks, CodeBlock *else_code_block) : if_expression(if_expression), if_code_block(if_code_block), else_if_expressions(else_if_expressions), else_if_code_blocks(else_if_code_blocks), else_code_block(else_code_block)
 {
-    this->type = "IfStatement";
+    this->kind = IfStatementNode;
 }
 
 void IfStatement::CheckSemantics(vector<Node*> call_stack)
@@ -517,7 +564,7 @@ ostream &operator<<(ostream &os, const IfStatement &data)
 
 SwitchStatement::SwitchStatement(Node *switch_expression, vector<Node*> case_expressions, vector<CodeBlock*> case_code_blocks, CodeBlock *default_code_block) : switch_expression(switch_expression), case_expressions(case_expressions), case_code_blocks(case_code_blocks), default_code_block(default_code_block)
 {
-    this->type = "SwitchStatement";
+    this->kind = SwitchStatementNode;
 }
 
 void SwitchStatement::CheckSemantics(vector<Node*> call_stack)
@@ -559,7 +606,7 @@ ostream &operator<<(ostream &os, const SwitchStatement &data)
 
 ForLoop::ForLoop(Node *declaration_expression, Node*condition_expression, Node *iteration_expression, CodeBlock *for_code_block) : declaration_expression(declaration_expression), condition_expression(condition_expression), iteration_expression(iteration_expression), for_code_block(for_code_block)
 {
-    this->type = "ForLoop";
+    this->kind = ForLoopNode;
 }
 
 void ForLoop::CheckSemantics(vector<Node*> call_stack)
@@ -572,6 +619,8 @@ void ForLoop::CheckSemantics(vector<Node*> call_stack)
     CheckStatement(this->iteration_expression, call_stack);
 
     CheckExpression(this->for_code_block, new_call_stack);
+
+    for_code_block->declares = DeclaresNames(for_code_block->content);
 }
 
 ostream &operator<<(ostream &os, const ForLoop &data)
@@ -602,7 +651,7 @@ ostream &operator<<(ostream &os, const ForLoop &data)
 
 ForEachLoop::ForEachLoop(Node *declaration_expression, Node *iteration_expression, CodeBlock *for_code_block) : declaration_expression(declaration_expression), iteration_expression(iteration_expression), for_code_block(for_code_block)
 {
-    this->type = "ForEachLoop";
+    this->kind = ForEachLoopNode;
 }
 
 void ForEachLoop::CheckSemantics(vector<Node*> call_stack)
@@ -623,7 +672,7 @@ ostream &operator<<(ostream &os, const ForEachLoop &data)
 
 WhileLoop::WhileLoop(Node *condition, CodeBlock *while_code_block) : condition(condition), while_code_block(while_code_block)
 {
-    this->type = "WhileLoop";
+    this->kind = WhileLoopNode;
 }
 
 void WhileLoop::CheckSemantics(vector<Node*> call_stack)
@@ -634,6 +683,8 @@ void WhileLoop::CheckSemantics(vector<Node*> call_stack)
     CheckExpression(this->condition, call_stack);
 
     CheckExpression(this->while_code_block, new_call_stack);
+
+    while_code_block->declares = DeclaresNames(while_code_block->content);
 }
 
 ostream &operator<<(ostream &os, const WhileLoop &data)
@@ -641,14 +692,62 @@ ostream &operator<<(ostream &os, const WhileLoop &data)
     return os << "while (" << *data.condition << ") " << *data.while_code_block;
 }
 
-Return::Return(Node *expression) : expression(expression)
+Return::Return(Node *expression) : expression(expression), tail_call(false)
 {
-    this->type = "Return";
+    this->kind = ReturnNode;
 }
 
 void Return::CheckSemantics(vector<Node*> call_stack)
 {
     CheckExpression(this->expression, call_stack);
+
+    tail_call = false;
+
+    if (this->expression == NULL || this->expression->kind != FunctionCallNode)
+    {
+        return;
+    }
+
+    // Scoping is dynamic, so a callee can read the frame it would replace. Only a function calling itself rebinds every
+    // name of that frame, and only when its body declares nothing but its parameters and the return is outside of loops.
+    for (int i = call_stack.size() - 1; i >= 0; i--)
+    {
+        NODE_KIND kind = call_stack[i]->kind;
+
+        if (kind == ForLoopNode || kind == ForEachLoopNode || kind == WhileLoopNode)
+        {
+            return;
+        }
+
+        // If, switch and loop bodies are code blocks too, only a block that is not one of those is a function body
+        NODE_KIND parent = i > 0 ? call_stack[i - 1]->kind : EmptyNode;
+
+        if (kind != CodeBlockNode || parent == IfStatementNode || parent == SwitchStatementNode || parent == ForLoopNode || parent == ForEachLoopNode || parent == WhileLoopNode)
+        {
+            continue;
+        }
+
+        CodeBlock *body = (CodeBlock*)call_stack[i];
+        string name = ((FunctionCall*)this->expression)->name;
+
+        // Methods also see the instance through the caller's frame
+        if (body->function_name != name || parent == ClassDefinitionNode)
+        {
+            return;
+        }
+
+        for (ParameterExpression &parameter : body->parameters)
+        {
+            if (parameter.name == name)
+            {
+                return;
+            }
+        }
+
+        tail_call = !DeclaresNames(body->content);
+
+        return;
+    }
 }
 
 ostream &operator<<(ostream &os, const Return &data)
@@ -665,7 +764,7 @@ ostream &operator<<(ostream &os, const Return &data)
 
 Break::Break()
 {
-    this->type = "Break";
+    this->kind = BreakNode;
 }
 
 ostream &operator<<(ostream &os, const Break &data)
@@ -675,7 +774,7 @@ ostream &operator<<(ostream &os, const Break &data)
 
 Continue::Continue()
 {
-    this->type = "Continue";
+    this->kind = ContinueNode;
 }
 
 ostream &operator<<(ostream &os, const Continue &data)
@@ -685,10 +784,70 @@ ostream &operator<<(ostream &os, const Continue &data)
 
 StatementEnd::StatementEnd()
 {
-    this->type = "StatementEnd";
+    this->kind = StatementEndNode;
 }
 
 ostream &operator<<(ostream &os, const StatementEnd &data)
 {
     return os;
+}
+
+const size_t Arena_Block_Size = 64 * 1024;
+
+NodeArena DefaultArena;
+
+NodeArena::NodeArena() : block_used(Arena_Block_Size)
+{
+
+}
+
+NodeArena::~NodeArena()
+{
+    Release();
+}
+
+void *NodeArena::Allocate(size_t size)
+{
+    size = (size + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+
+    // Nodes larger than a block get a block of their own, the current block keeps being filled
+    if (size > Arena_Block_Size)
+    {
+        char *block = (char*)::operator new(size);
+
+        blocks.insert(blocks.begin(), block);
+
+        return block;
+    }
+
+    if (block_used + size > Arena_Block_Size)
+    {
+        blocks.push_back((char*)::operator new(Arena_Block_Size));
+
+        block_used = 0;
+    }
+
+    void *memory = blocks.back() + block_used;
+
+    block_used += size;
+
+    return memory;
+}
+
+void NodeArena::Release()
+{
+    for (int i = nodes.size() - 1; i >= 0; i--)
+    {
+        nodes[i]->~Node();
+    }
+
+    for (char *block : blocks)
+    {
+        ::operator delete(block);
+    }
+
+    nodes.clear();
+    blocks.clear();
+
+    block_used = Arena_Block_Size;
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include <iostream>
 #include <tuple>
 #include <optional>
+#include <memory>
+#include <cstddef>
+#include <new>
 
 #include "error.hpp"
 
@@ -16,7 +19,64 @@ enum ARGUMENT_EXPANSION
     Dictionary,
 };
 
-extern std::vector<std::string> Operator_Preference;
+enum NODE_KIND
+{
+    EmptyNode,
+    TypeExpressionNode,
+    ParameterExpressionNode,
+    QualifierExpressionNode,
+    LiteralNode,
+    CodeBlockNode,
+    OperationNode,
+    GetVariableNode,
+    DeclareVariableNode,
+    FunctionCallNode,
+    ClassDefinitionNode,
+    InstanceClassNode,
+    MemberAccessNode,
+    IfStatementNode,
+    SwitchStatementNode,
+    ForLoopNode,
+    ForEachLoopNode,
+    WhileLoopNode,
+    ReturnNode,
+    BreakNode,
+    ContinueNode,
+    StatementEndNode,
+};
+
+enum OPERATOR
+{
+    UnknownOperator,
+    NotOperator,
+    NegativeOperator,
+    PositiveOperator,
+    PowOperator,
+    MultiplyOperator,
+    DivideOperator,
+    IntDivideOperator,
+    ModuloOperator,
+    AddOperator,
+    SubtractOperator,
+    EqualityOperator,
+    InequalityOperator,
+    GreaterEqualOperator,
+    LessEqualOperator,
+    GreaterOperator,
+    LessOperator,
+    AndOperator,
+    OrOperator,
+    AssignmentOperator,
+    AddAssignmentOperator,
+    SubtractAssignmentOperator,
+    MultiplyAssignmentOperator,
+    DivideAssignmentOperator,
+};
+
+class Object;
+class FunctionObject;
+
+OPERATOR GetOperator(std::string operator_string, bool unary);
 
 void ThrowError(int start, int end, Error error);
 
@@ -25,13 +85,15 @@ class Node
     public:
         std::optional<Error> error;
 
-        std::string type;
+        NODE_KIND kind;
         int start;
         int end;
 
         Node();
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        virtual ~Node();
+
+        virtual void CheckSemantics(std::vector<Node*> call_stack);
 
         friend std::ostream &operator<<(std::ostream &os, const Node &n);
 };
@@ -42,11 +104,12 @@ class TypeExpression : public Node
         std::string name;
         bool is_array;
         std::vector<TypeExpression> content;
+        // Class the name resolved to, reused while Type_Generation has not changed
+        std::shared_ptr<Object> cached_type;
+        int cached_generation;
 
         TypeExpression(std::string name, bool is_array, std::vector<TypeExpression> content);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
-
         friend std::ostream &operator<<(std::ostream &os, const TypeExpression &data);
 };
 
@@ -82,11 +145,11 @@ class Literal : public Node
         std::optional<double> l_float;
         std::optional<std::string> l_string;
         std::optional<bool> l_boolean;
+        // String literals are boxed once and the object is shared by every evaluation
+        std::shared_ptr<Object> constant;
 
         Literal();
 
-        void CheckSemantics(std::vector<Node*> call_stack);
-
         friend std::ostream &operator<<(std::ostream &os, const Literal &data);
 };
 
@@ -96,24 +159,49 @@ class CodeBlock : public Node
         TypeExpression return_type;
         std::vector<ParameterExpression> parameters;
         std::vector<Node*> content;
+        // Loop bodies that declare no names run in the enclosing scope instead of a new scope per iteration
+        bool declares;
+        // Name of the function declared with this block, empty for other blocks
+        std::string function_name;
+        // Function built the first time the block is evaluated, later evaluations share it while its types resolve to the same classes
+        std::shared_ptr<FunctionObject> prototype;
 
         CodeBlock(TypeExpression return_type, std::vector<ParameterExpression> parameters, std::vector<Node*> content);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const CodeBlock &data);
 };
 
+// Remembers the methods an operation resolved to for the last few operand types, keyed by type definition
+class InlineCache
+{
+    public:
+        static const int Capacity = 4;
+
+        std::shared_ptr<Object> types[Capacity];
+        std::shared_ptr<Object> methods[Capacity];
+        int size;
+
+        InlineCache();
+
+        Object *Find(Object *type);
+
+        void Add(std::shared_ptr<Object> type, std::shared_ptr<Object> method);
+};
+
 class Operation : public Node
 {
     public:
         std::string operator_string;
+        OPERATOR operator_code;
         Node *left;
         Node *right;
+        InlineCache cache;
 
         Operation(std::string operator_string, Node *left, Node *right);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const Operation &data);
 };
@@ -125,8 +213,6 @@ class GetVariable : public Node
 
         GetVariable(std::string name);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
-
         friend std::ostream &operator<<(std::ostream &os, const GetVariable &data);
 };
 
@@ -140,7 +226,7 @@ class DeclareVariable : public Node
 
         DeclareVariable(QualifierExpression *qualifier, TypeExpression variable_type, std::string name, Node *value);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const DeclareVariable &data);
 };
@@ -153,7 +239,7 @@ class FunctionCall : public Node
 
         FunctionCall(std::string name, std::vector<Node*> arguments);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const FunctionCall &data);
 };
@@ -167,7 +253,7 @@ class ClassDefinition : public Node
         
         ClassDefinition(std::string name, std::string interface, std::vector<Node*> body);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const ClassDefinition &data);
 };
@@ -180,7 +266,7 @@ class InstanceClass : public Node
 
         InstanceClass(std::string name, std::vector<Node*> arguments);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const InstanceClass &data);
 };
@@ -190,10 +276,13 @@ class MemberAccess : public Node
     public:
         std::string name;
         Node *statement;
+        // Class last read through this site and the slot of the attribute in its shape, -1 for a method
+        std::shared_ptr<Object> cached_class;
+        int cached_slot;
 
         MemberAccess(std::string name, Node *statement);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const MemberAccess &data);
 };
@@ -209,7 +298,7 @@ class IfStatement : public Node
 
         IfStatement(Node *if_expression, CodeBlock *if_code_block, std::vector<Node*> else_if_expressions, std::vector<CodeBlock*> else_if_code_blocks, CodeBlock *else_code_block);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const IfStatement &data);
 };
@@ -224,7 +313,7 @@ class SwitchStatement : public Node
 
         SwitchStatement(Node *switch_expression, std::vector<Node*> case_expressions, std::vector<CodeBlock*> case_code_blocks, CodeBlock *default_code_block);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const SwitchStatement &data);
 };
@@ -239,7 +328,7 @@ class ForLoop : public Node
 
         ForLoop(Node *declaration_expression, Node *condition_expression, Node *iteration_expression, CodeBlock *for_code_block);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const ForLoop &data);
 };
@@ -253,7 +342,7 @@ class ForEachLoop : public Node
 
         ForEachLoop(Node *declaration_expression, Node *iteration_expression, CodeBlock *for_code_block);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const ForEachLoop &data);
 };
@@ -266,7 +355,7 @@ class WhileLoop : public Node
 
         WhileLoop(Node *condition, CodeBlock *while_code_block);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const WhileLoop &data);
 };
@@ -275,10 +364,12 @@ class Return : public Node
 {
     public:
         Node *expression;
+        // Set by semantic analysis when the returned expression is a call that can replace the current frame
+        bool tail_call;
 
         Return(Node *expression);
 
-        void CheckSemantics(std::vector<Node*> call_stack);
+        void CheckSemantics(std::vector<Node*> call_stack) override;
 
         friend std::ostream &operator<<(std::ostream &os, const Return &data);
 };
@@ -288,8 +379,6 @@ class Break : public Node
     public:
         Break();
 
-        void CheckSemantics(std::vector<Node*> call_stack);
-
         friend std::ostream &operator<<(std::ostream &os, const Break &data);
 };
 
@@ -298,8 +387,6 @@ class Continue : public Node
     public:
         Continue();
 
-        void CheckSemantics(std::vector<Node*> call_stack);
-
         friend std::ostream &operator<<(std::ostream &os, const Continue &data);
 };
 
@@ -311,4 +398,35 @@ class StatementEnd : public Node
         friend std::ostream &operator<<(std::ostream &os, const StatementEnd &data);
 };
 
+// Owns every node of a compilation unit, nodes are packed into large blocks in the order they are parsed
+// and are all destroyed together when the arena is released
+class NodeArena
+{
+    public:
+        std::vector<char*> blocks;
+        size_t block_used;
+        std::vector<Node*> nodes;
+
+        NodeArena();
+        NodeArena(const NodeArena&) = delete;
+        NodeArena &operator=(const NodeArena&) = delete;
+        ~NodeArena();
+
+        void *Allocate(size_t size);
+
+        template <typename T>
+        T *Create(T node_data)
+        {
+            T *node = new (Allocate(sizeof(T))) T(std::move(node_data));
+
+            nodes.push_back(node);
+
+            return node;
+        }
+
+        void Release();
+};
+
+extern NodeArena DefaultArena;
+
 #endif
\ No newline at end of file
@@ -8,11 +8,26 @@
 #include <memory>
 #include <cmath>
 #include <ctime>
+#include <chrono>
+#include <algorithm>
 
 #include "object.hpp"
 #include "node.hpp"
 #include "error.hpp"
 
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#include <sanitizer/asan_interface.h>
+#endif
+#endif
+
+#ifndef ASAN_POISON_MEMORY_REGION
+#define ASAN_POISON_MEMORY_REGION(address, size) ((void)(address), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(address, size) ((void)(address), (void)(size))
+#endif
+
 using namespace std;
 
 Type::Type(shared_ptr<Object> type_definition) : type_definition(type_definition)
@@ -32,6 +47,11 @@ bool Type::operator!=(Type other)
 
 ostream &operator<<(ostream &os, const Type &type)
 {
+    if (!type.type_definition)
+    {
+        return os << "void";
+    }
+
     return os << *type.type_definition;
 }
 
@@ -77,11 +97,100 @@ ostream &operator<<(ostream &os, const Qualifier &qualifier)
     return os << s;
 }
 
+SlabAllocator DefaultAllocator = {};
+
+void *SlabAllocator::Allocate(size_t size)
+{
+    if (!Slab_Allocation || size > Size_Classes * Size_Class_Step)
+    {
+        return ::operator new(size);
+    }
+
+    int size_class = (size - 1) / Size_Class_Step;
+    size_t block_size = (size_class + 1) * Size_Class_Step;
+
+    live_blocks[size_class]++;
+
+    if (void *block = free_lists[size_class])
+    {
+        ASAN_UNPOISON_MEMORY_REGION(block, block_size);
+
+        free_lists[size_class] = *(void**)block;
+
+        return block;
+    }
+
+    if (limit - cursor < (ptrdiff_t)block_size)
+    {
+        cursor = (char*)::operator new(Slab_Size);
+        limit = cursor + Slab_Size;
+        slab_bytes += Slab_Size;
+
+        ASAN_POISON_MEMORY_REGION(cursor, Slab_Size);
+    }
+
+    void *block = cursor;
+    cursor += block_size;
+
+    ASAN_UNPOISON_MEMORY_REGION(block, block_size);
+
+    return block;
+}
+
+void SlabAllocator::Free(void *pointer, size_t size)
+{
+    if (!Slab_Allocation || size > Size_Classes * Size_Class_Step)
+    {
+        ::operator delete(pointer);
+
+        return;
+    }
+
+    int size_class = (size - 1) / Size_Class_Step;
+
+    live_blocks[size_class]--;
+
+    *(void**)pointer = free_lists[size_class];
+    free_lists[size_class] = pointer;
+
+    ASAN_POISON_MEMORY_REGION(pointer, (size_class + 1) * Size_Class_Step);
+}
+
+ostream &operator<<(ostream &os, SlabAllocator &allocator)
+{
+    const long long *live = allocator.live_objects;
+
+    os << "Objects: " << live[StringAllocation] << " strings, " << live[TypeAllocation] << " types, " << live[TypeDefinitionAllocation] << " classes, ";
+    os << live[InstanceAllocation] << " instances, " << live[FunctionAllocation] << " functions, " << live[EnvironmentAllocation] << " environments\n";
+
+    os << "Slabs: " << allocator.slab_bytes << " bytes, live blocks by size {";
+
+    for (int i = 0; i < Size_Classes; i++)
+    {
+        if (allocator.live_blocks[i])
+        {
+            os << (i + 1) * Size_Class_Step << ": " << allocator.live_blocks[i] << ", ";
+        }
+    }
+
+    return os << "}";
+}
+
 Object::Object() : type(Type(NULL))
 {
     
 }
 
+void *Object::operator new(size_t size)
+{
+    return DefaultAllocator.Allocate(size);
+}
+
+void Object::operator delete(void *pointer, size_t size)
+{
+    DefaultAllocator.Free(pointer, size);
+}
+
 Object::~Object()
 {
 
@@ -92,14 +201,95 @@ ostream &operator<<(ostream &os, Object &object)
     return os << object.to_string();
 }
 
-Member::Member(shared_ptr<Object> object, Qualifier qualifiers) : qualifiers(qualifiers), object(object)
+Value::Value() : tag(VoidValue), int_value(0)
+{
+
+}
+
+Value::Value(int value) : tag(IntValue), int_value(value)
+{
+
+}
+
+Value::Value(float value) : tag(FloatValue), float_value(value)
+{
+
+}
+
+Value::Value(bool value) : tag(BoolValue), bool_value(value)
+{
+
+}
+
+Value::Value(shared_ptr<Object> object) : tag(ObjectValue), int_value(0), object(object)
+{
+
+}
+
+Type Value::GetType() const
+{
+    switch (tag)
+    {
+        case IntValue:
+            return Type(IntDefinition);
+        case FloatValue:
+            return Type(FloatDefinition);
+        case BoolValue:
+            return Type(BoolDefinition);
+        case ObjectValue:
+            return object->type;
+        default:
+            return Type(NULL);
+    }
+}
+
+Object *Value::GetTypeDefinition() const
+{
+    switch (tag)
+    {
+        case IntValue:
+            return IntDefinition.get();
+        case FloatValue:
+            return FloatDefinition.get();
+        case BoolValue:
+            return BoolDefinition.get();
+        case ObjectValue:
+            return object->type.type_definition.get();
+        default:
+            return NULL;
+    }
+}
+
+string Value::to_string() const
+{
+    switch (tag)
+    {
+        case IntValue:
+            return std::to_string(int_value);
+        case FloatValue:
+            return std::to_string(float_value);
+        case BoolValue:
+            return bool_value ? "true" : "false";
+        case ObjectValue:
+            return object->to_string();
+        default:
+            return "void";
+    }
+}
+
+ostream &operator<<(ostream &os, const Value &value)
+{
+    return os << value.to_string();
+}
+
+Member::Member(Value value, Qualifier qualifiers) : qualifiers(qualifiers), value(value)
 {
     
 }
 
 ostream &operator<<(ostream &os, const Member &member)
 {
-    return os << member.qualifiers << " " << *member.object;
+    return os << member.qualifiers << " " << member.value;
 }
 
 Parameter::Parameter(Type type, string name, optional<Node*> default_argument, ARGUMENT_EXPANSION argument_expansion) : type(type), name(name), default_argument(default_argument), argument_expansion(argument_expansion)
@@ -130,127 +320,237 @@ ostream &operator<<(ostream &os, const Parameter &data)
     return os;
 }
 
-Variable::Variable(shared_ptr<Object> object, Qualifier qualifiers) : qualifiers(qualifiers), object(object)
+Variable::Variable() : qualifiers(Qualifier())
 {
-    
+    value.tag = EmptyValue;
 }
 
-ostream &operator<<(ostream &os, const Variable &variable)
+Variable::Variable(Value value, Qualifier qualifiers) : qualifiers(qualifiers), value(value)
 {
-    return os << variable.qualifiers << " " << *variable.object;
+    
 }
 
-Environment::Environment(shared_ptr<Environment> parent_environment, map<string, Variable> variables) : parent_environment(parent_environment), variables(variables)
+ostream &operator<<(ostream &os, const Variable &variable)
 {
-
+    return os << variable.qualifiers << " " << variable.value;
 }
 
-optional<Variable> Environment::Get(string name)
+Environment::Environment(shared_ptr<Environment> parent_environment, map<string, Variable> variables) : parent_environment(parent_environment), defines_classes(false)
 {
-    auto var = variables.find(name);
+    DefaultAllocator.live_objects[EnvironmentAllocation]++;
 
-    if (var != variables.end())
+    for (auto& [name, variable] : variables)
     {
-        return optional<Variable>(var->second);
+        Add(name, variable);
     }
+}
 
-    if (parent_environment)
-    {
-        return parent_environment->Get(name);
-    }
+Environment::Environment(shared_ptr<Environment> parent_environment, int slot_count) : parent_environment(parent_environment), slots(slot_count), defines_classes(false)
+{
+    DefaultAllocator.live_objects[EnvironmentAllocation]++;
+}
 
-    return optional<Variable>();
+void *Environment::operator new(size_t size)
+{
+    return DefaultAllocator.Allocate(size);
 }
 
-void Environment::Add(string name, Variable variable)
+void Environment::operator delete(void *pointer, size_t size)
 {
-    variables.insert({ name, variable });
+    DefaultAllocator.Free(pointer, size);
 }
 
-ostream &operator<<(ostream &os, const Environment &environment)
+Variable *Environment::Get(string name)
 {
-    os << "{";
+    Environment *env = this;
 
-    for (auto pair : environment.variables)
+    while (env != NULL)
     {
-        os << pair.first << ": " << pair.second << ", ";
-    }
+        if (env->slot_names)
+        {
+            auto slot = env->slot_names->find(name);
 
-    os << "}";
+            // Laid out names only count once their slot has been declared
+            if (slot != env->slot_names->end() && env->slots[slot->second].value.tag != EmptyValue)
+            {
+                return &env->slots[slot->second];
+            }
+        }
 
-    if (environment.parent_environment)
-    {
-        os << "\nParent: " << *environment.parent_environment;
-    }
+        auto var = env->names.find(name);
 
-    return os;
-}
+        if (var != env->names.end())
+        {
+            return &env->slots[var->second];
+        }
 
-Call::Call(std::string node_type, std::optional<Type> return_type) : node_type(node_type), return_type(return_type)
-{
+        if (env->instance)
+        {
+            ClassInstanceObject *object = (ClassInstanceObject*)env->instance.get();
 
+            int slot = object->GetShape().Find(name);
+
+            if (slot != -1)
+            {
+                return &object->slots[slot];
+            }
+        }
+
+        env = env->parent_environment.get();
+    }
+
+    return NULL;
 }
 
-ostream &operator<<(ostream &os, const Call &call)
+Variable *Environment::Get(int depth, int slot)
 {
-    if (call.return_type)
+    Environment *env = this;
+
+    for (int i = 0; i < depth; i++)
     {
-        return os << "Call: " << call.node_type << "(" << call.return_type.value() << ")";
+        env = env->parent_environment.get();
     }
-    else
+
+    if (env->slots[slot].value.tag == EmptyValue)
     {
-        return os << "Call: " << call.node_type << "()";
+        return NULL;
     }
+
+    return &env->slots[slot];
 }
 
-IntObject::IntObject(int value) : value(value)
+Variable *Environment::Find(string name, int depth, int slot)
 {
-    this->type = Type(Types->Get("int")->object);
+    if (slot >= 0)
+    {
+        Variable *var = Get(depth, slot);
+
+        if (var)
+        {
+            return var;
+        }
+    }
+
+    return Get(name);
 }
 
-string IntObject::to_string()
+bool Environment::Declares(string name)
 {
-    return std::to_string(value);
+    if (slot_names)
+    {
+        auto slot = slot_names->find(name);
+
+        if (slot != slot_names->end() && slots[slot->second].value.tag != EmptyValue)
+        {
+            return true;
+        }
+    }
+
+    return names.find(name) != names.end();
 }
 
-IntObject::~IntObject()
+void Environment::Add(string name, Variable variable)
 {
+    if (names.find(name) != names.end())
+    {
+        return;
+    }
 
+    names.insert({ name, slots.size() });
+    slots.push_back(variable);
 }
 
-FloatObject::FloatObject(float value) : value(value)
+void Environment::Set(int slot, string name, Variable variable)
 {
-    this->type = Type(Types->Get("float")->object);
+    slots[slot] = variable;
+
+    if (!slot_names)
+    {
+        names[name] = slot;
+    }
 }
 
-string FloatObject::to_string()
+map<string, Variable> Environment::Variables() const
 {
-    return std::to_string(value);
+    map<string, Variable> variables = {};
+
+    if (slot_names)
+    {
+        for (auto& [name, slot] : *slot_names)
+        {
+            if (slots[slot].value.tag != EmptyValue)
+            {
+                variables.insert({ name, slots[slot] });
+            }
+        }
+    }
+
+    for (auto& [name, slot] : names)
+    {
+        variables.insert({ name, slots[slot] });
+    }
+
+    return variables;
 }
 
-FloatObject::~FloatObject()
+ostream &operator<<(ostream &os, const Environment &environment)
 {
+    os << "{";
+
+    for (auto& [name, variable] : environment.Variables())
+    {
+        os << name << ": " << variable << ", ";
+    }
+
+    os << "}";
 
+    if (environment.parent_environment)
+    {
+        os << "\nParent: " << *environment.parent_environment;
+    }
+
+    return os;
 }
 
-BoolObject::BoolObject(bool value) : value(value)
+Environment::~Environment()
 {
-    this->type = Type(Types->Get("bool")->object);
+    DefaultAllocator.live_objects[EnvironmentAllocation]--;
+
+    if (defines_classes)
+    {
+        Type_Generation++;
+    }
 }
 
-string BoolObject::to_string()
+int Max_Call_Depth = 10000;
+
+int Type_Generation = 0;
+
+Call::Call(NODE_KIND node_kind, std::optional<Type> return_type, Node *node, Call *parent) : node_kind(node_kind), return_type(return_type), node(node), parent(parent)
 {
-    return value ? "true" : "false";
+    depth = (parent ? parent->depth : 0) + (node_kind == FunctionCallNode ? 1 : 0);
+
 }
 
-BoolObject::~BoolObject()
+ostream &operator<<(ostream &os, const Call &call)
 {
-
+    if (call.return_type)
+    {
+        return os << "Call: " << call.node_kind << "(" << call.return_type.value() << ")";
+    }
+    else
+    {
+        return os << "Call: " << call.node_kind << "()";
+    }
 }
 
 StringObject::StringObject(string value) : value(value)
 {
-    this->type = Type(Types->Get("string")->object);
+    this->kind = StringObjectKind;
+
+    DefaultAllocator.live_objects[StringAllocation]++;
+
+    this->type = Type(Types->Get("string")->value.object);
 }
 
 string StringObject::to_string()
@@ -260,12 +560,16 @@ string StringObject::to_string()
 
 StringObject::~StringObject()
 {
-
+    DefaultAllocator.live_objects[StringAllocation]--;
 }
 
 TypeObject::TypeObject(Type value) : value(value)
 {
-    this->type = Type(Types->Get("Type")->object);
+    this->kind = TypeObjectKind;
+
+    DefaultAllocator.live_objects[TypeAllocation]++;
+
+    this->type = Type(Types->Get("Type")->value.object);
 }
 
 string TypeObject::to_string()
@@ -278,12 +582,50 @@ string TypeObject::to_string()
 
 TypeObject::~TypeObject()
 {
+    DefaultAllocator.live_objects[TypeAllocation]--;
+}
+
+Shape::Shape()
+{
+
+}
+
+int Shape::Add(string name, Member member)
+{
+    slots.insert({ name, names.size() });
+    names.push_back(name);
+    qualifiers.push_back(member.qualifiers);
+    defaults.push_back(Variable(member.value, member.qualifiers));
+
+    return names.size() - 1;
+}
+
+int Shape::Find(const string &name)
+{
+    auto slot = slots.find(name);
+
+    if (slot != slots.end())
+    {
+        return slot->second;
+    }
 
+    return -1;
 }
 
 TypeDefinitionObject::TypeDefinitionObject(string name, map<string, Member> members) : name(name), members(members)
 {
-    
+    this->kind = TypeDefinitionObjectKind;
+
+    DefaultAllocator.live_objects[TypeDefinitionAllocation]++;
+
+    // Methods stay on the class, attributes become slots of the instances
+    for (auto& [member_name, member] : members)
+    {
+        if (!ObjectCast<FunctionObject>(member.value.object.get()))
+        {
+            shape.Add(member_name, member);
+        }
+    }
 }
 
 optional<Member> TypeDefinitionObject::GetMember(string name)
@@ -322,22 +664,33 @@ string TypeDefinitionObject::to_string()
 
 TypeDefinitionObject::~TypeDefinitionObject()
 {
-
+    DefaultAllocator.live_objects[TypeDefinitionAllocation]--;
 }
 
-ClassInstanceObject::ClassInstanceObject(shared_ptr<Object> class_type, map<string, Member> members) : members(members)
+ClassInstanceObject::ClassInstanceObject(shared_ptr<Object> class_type) : slots(((TypeDefinitionObject*)class_type.get())->shape.defaults), heap_generation(0), heap_index(-1), gc_references(-1), reachable(false)
 {
+    this->kind = ClassInstanceObjectKind;
+
+    DefaultAllocator.live_objects[InstanceAllocation]++;
+
     this->type = Type(class_type);
 }
 
+Shape &ClassInstanceObject::GetShape()
+{
+    return ((TypeDefinitionObject*)type.type_definition.get())->shape;
+}
+
 string ClassInstanceObject::to_string()
 {
+    Shape &shape = GetShape();
+
     stringstream s;
     s << type << " instance {";
 
-    for (auto pair : members)
+    for (int i = 0; i < slots.size(); i++)
     {
-        s << pair.first << ": " << pair.second << ", ";
+        s << shape.names[i] << ": " << Member(slots[i].value, slots[i].qualifiers) << ", ";
     }
 
     s << "}";
@@ -347,12 +700,230 @@ string ClassInstanceObject::to_string()
 
 ClassInstanceObject::~ClassInstanceObject()
 {
+    DefaultAllocator.live_objects[InstanceAllocation]--;
+
+    if (heap_index >= 0)
+    {
+        DefaultHeap.Untrack(this);
+    }
+}
+
+// A collection runs once this many instances were created and are still alive since the last one
+const int Nursery_Size = 1024;
+// Full collections run once the old generation outgrows its limit, the limit then doubles with the survivors
+const int Old_Generation_Size = 8192;
+
+Heap DefaultHeap;
+
+Heap::Heap() : old_generation_limit(Old_Generation_Size), collections(0), full_collections(0), collected(0), total_pause(0), longest_pause(0)
+{
+
+}
+
+Heap::~Heap()
+{
+    // Instances destroyed after the heap, during static destruction, see that they are no longer tracked and leave it alone
+    for (vector<ClassInstanceObject*> *generation : { &nursery, &old_generation })
+    {
+        for (ClassInstanceObject *object : *generation)
+        {
+            object->heap_index = -1;
+        }
+    }
+}
+
+void Heap::Track(ClassInstanceObject *object)
+{
+    object->heap_generation = 0;
+    object->heap_index = nursery.size();
+    nursery.push_back(object);
+
+    if (nursery.size() >= Nursery_Size)
+    {
+        Collect(old_generation.size() >= old_generation_limit);
+    }
+}
+
+void Heap::Untrack(ClassInstanceObject *object)
+{
+    vector<ClassInstanceObject*> &generation = object->heap_generation == 0 ? nursery : old_generation;
+
+    generation[object->heap_index] = generation.back();
+    generation[object->heap_index]->heap_index = object->heap_index;
+    generation.pop_back();
+
+    object->heap_index = -1;
+}
+
+static ClassInstanceObject *GetCandidate(const Value &value)
+{
+    ClassInstanceObject *object = ObjectCast<ClassInstanceObject>(value.object.get());
+
+    return object && object->gc_references >= 0 ? object : NULL;
+}
+
+int Heap::Collect(bool full)
+{
+    auto start = chrono::steady_clock::now();
+
+    vector<ClassInstanceObject*> candidates = nursery;
+
+    if (full)
+    {
+        candidates.insert(candidates.end(), old_generation.begin(), old_generation.end());
+    }
+
+    for (ClassInstanceObject *object : candidates)
+    {
+        object->gc_references = object->weak_from_this().use_count();
+        object->reachable = false;
+    }
+
+    // Whatever is left after removing the references between candidates is held by an environment, the stack or the host
+    for (ClassInstanceObject *object : candidates)
+    {
+        for (const Variable &variable : object->slots)
+        {
+            if (ClassInstanceObject *target = GetCandidate(variable.value))
+            {
+                target->gc_references--;
+            }
+        }
+    }
+
+    vector<ClassInstanceObject*> pending;
+
+    for (ClassInstanceObject *object : candidates)
+    {
+        if (object->gc_references > 0)
+        {
+            object->reachable = true;
+            pending.push_back(object);
+        }
+    }
+
+    while (!pending.empty())
+    {
+        ClassInstanceObject *object = pending.back();
+        pending.pop_back();
+
+        for (const Variable &variable : object->slots)
+        {
+            ClassInstanceObject *target = GetCandidate(variable.value);
+
+            if (target && !target->reachable)
+            {
+                target->reachable = true;
+                pending.push_back(target);
+            }
+        }
+    }
+
+    // Survivors are promoted, the garbage leaves the heap before its cycles are broken
+    nursery.clear();
+
+    if (full)
+    {
+        old_generation.clear();
+    }
+
+    vector<shared_ptr<ClassInstanceObject>> garbage;
+
+    for (ClassInstanceObject *object : candidates)
+    {
+        object->gc_references = -1;
+
+        if (object->reachable)
+        {
+            object->heap_generation = 1;
+            object->heap_index = old_generation.size();
+            old_generation.push_back(object);
+        }
+        else
+        {
+            object->heap_index = -1;
+            garbage.push_back(object->shared_from_this());
+        }
+    }
+
+    vector<Variable> released;
+
+    for (shared_ptr<ClassInstanceObject> &object : garbage)
+    {
+        move(object->slots.begin(), object->slots.end(), back_inserter(released));
+        object->slots.clear();
+    }
+
+    released.clear();
+
+    int count = garbage.size();
+
+    garbage.clear();
+
+    if (full)
+    {
+        old_generation_limit = max((size_t)Old_Generation_Size, old_generation.size() * 2);
+        full_collections++;
+    }
+
+    double pause = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    collections++;
+    collected += count;
+    total_pause += pause;
+    longest_pause = max(longest_pause, pause);
+
+    return count;
+}
+
+size_t Heap::Size()
+{
+    size_t size = 0;
 
+    for (vector<ClassInstanceObject*> *generation : { &nursery, &old_generation })
+    {
+        for (ClassInstanceObject *object : *generation)
+        {
+            size += sizeof(ClassInstanceObject) + object->slots.size() * sizeof(Variable);
+        }
+    }
+
+    return size;
+}
+
+ostream &operator<<(ostream &os, Heap &heap)
+{
+    os << "Heap: " << heap.nursery.size() + heap.old_generation.size() << " instances (" << heap.Size() << " bytes), ";
+    os << heap.collections << " collections (" << heap.full_collections << " full), " << heap.collected << " instances collected, ";
+
+    return os << "pauses " << heap.total_pause << "ms total, " << heap.longest_pause << "ms longest";
 }
 
-FunctionObject::FunctionObject(Type return_type, vector<Parameter> parameters, variant<vector<Node*>, function<shared_ptr<Object>(shared_ptr<Environment>)>> body) : return_type(return_type), parameters(parameters), body(body)
+shared_ptr<Object> CreateInstance(shared_ptr<Object> class_type)
 {
-    this->type = Type(Types->Get("Function")->object);
+    shared_ptr<ClassInstanceObject> instance = shared_ptr<ClassInstanceObject>(new ClassInstanceObject(class_type));
+
+    DefaultHeap.Track(instance.get());
+
+    return instance;
+}
+
+FunctionObject::FunctionObject(Type return_type, vector<Parameter> parameters, variant<vector<Node*>, NativeFunction> body) : return_type(return_type), parameters(parameters), body(body)
+{
+    this->kind = FunctionObjectKind;
+
+    SlotNames names = {};
+
+    for (int i = 0; i < parameters.size(); i++)
+    {
+        names[parameters[i].name] = i;
+    }
+
+    parameter_names = make_shared<const SlotNames>(names);
+
+    DefaultAllocator.live_objects[FunctionAllocation]++;
+
+    this->type = Type(Types->Get("Function")->value.object);
 }
 
 string FunctionObject::to_string()
@@ -394,27 +965,12 @@ string FunctionObject::to_string()
 
 FunctionObject::~FunctionObject()
 {
-
-}
-
-VoidObject::VoidObject()
-{
-
-}
-
-string VoidObject::to_string()
-{
-    return "void";
-}
-
-VoidObject::~VoidObject()
-{
-
+    DefaultAllocator.live_objects[FunctionAllocation]--;
 }
 
 ErrorObject::ErrorObject(int start, int end, Error error) : start(start), end(end), error(error)
 {
-
+    this->kind = ErrorObjectKind;
 }
 
 string ErrorObject::to_string()
@@ -432,7 +988,7 @@ ErrorObject::~ErrorObject()
 
 shared_ptr<Environment> InitialiseInterpreterData()
 {
-    Types->variables = {
+    *Types = Environment(NULL, {
         { "void", Variable(shared_ptr<Object>(new TypeDefinitionObject("void", {})), Qualifier()) },
         { "int", Variable(shared_ptr<Object>(new TypeDefinitionObject("int", {})), Qualifier()) },
         { "float", Variable(shared_ptr<Object>(new TypeDefinitionObject("float", {})), Qualifier()) },
@@ -440,7 +996,13 @@ shared_ptr<Environment> InitialiseInterpreterData()
         { "string", Variable(shared_ptr<Object>(new TypeDefinitionObject("string", {})), Qualifier()) },
         { "Type", Variable(shared_ptr<Object>(new TypeDefinitionObject("Type", {})), Qualifier()) },
         { "Function", Variable(shared_ptr<Object>(new TypeDefinitionObject("Function", {})), Qualifier()) },
-    };
+    });
+
+    IntDefinition = Types->Get("int")->value.object;
+    FloatDefinition = Types->Get("float")->value.object;
+    BoolDefinition = Types->Get("bool")->value.object;
+
+    Type_Generation++;
 
     CreateIntMethods();
     CreateFloatMethods();
@@ -460,44 +1022,36 @@ map<string, Member> VariablesToMembers(map<string, Variable> variables)
 
     for (auto& [member_name, member_value] : variables)
     {
-        members.insert({member_name, Member(member_value.object, member_value.qualifiers)});
+        members.insert({member_name, Member(member_value.value, member_value.qualifiers)});
     }
 
     return members;
 }
 
-map<string, Variable> MembersToVariables(map<string, Member> members)
-{
-    map<string, Variable> variables = {};
-
-    for (auto& [variable_name, variable_value] : members)
-    {
-        variables.insert({variable_name, Variable(variable_value.object, variable_value.qualifiers)});
-    }
-
-    return variables;
-}
-
 shared_ptr<Environment> Types = std::shared_ptr<Environment>(new Environment(NULL, std::map<std::string, Variable> {}));
 
+shared_ptr<Object> IntDefinition = NULL;
+shared_ptr<Object> FloatDefinition = NULL;
+shared_ptr<Object> BoolDefinition = NULL;
+
 map<string, Variable> CreateBuiltinFunctions()
 {
-    auto print = [](shared_ptr<Environment> env)
+    NativeFunction print = [] (const Value *arguments, int)
     {
-        cout << ((StringObject*)(env->Get("value")->object.get()))->value;
-        return shared_ptr<Object>(new VoidObject());
+        cout << ((StringObject*)arguments[0].object.get())->value;
+        return Value();
     };
 
-    auto input = [](shared_ptr<Environment> env)
+    NativeFunction input = [] (const Value *, int)
     {
         string input;
         cin >> input;
-        return shared_ptr<Object>(new StringObject(input));
+        return Value(shared_ptr<Object>(new StringObject(input)));
     };
 
-    auto random = [](shared_ptr<Environment> env)
+    NativeFunction random = [] (const Value *arguments, int)
     {
-        int seed = ((IntObject*)(env->Get("seed")->object.get()))->value;
+        int seed = arguments[0].int_value;
         if (seed < 0)
         {
             seed = time(NULL);
@@ -505,394 +1059,380 @@ map<string, Variable> CreateBuiltinFunctions()
 
         srand(seed);
 
-        shared_ptr<Object> random_number = shared_ptr<Object>(new IntObject(rand()));
+        Value random_number = Value(rand());
 
         return random_number;
     };
 
-    Literal *random_default_arg = new Literal();
+    // The default seed is created once and owned by the arena, like the nodes of a parsed program
+    static Literal *random_default_arg = DefaultArena.Create(Literal());
     random_default_arg->l_integer = -1;
 
     map<string, Variable> functions = {
-        { "print", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("void")->object), {Parameter(Type(Types->Get("string")->object), "value", optional<Node*>(), None)}, print)), Qualifier()) },
-        { "input", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("string")->object), {}, input)), Qualifier()) },
-        { "random", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("int")->object), {Parameter(Type(Types->Get("int")->object), "seed", optional<Node*>(random_default_arg), None)}, random)), Qualifier()) },
+        { "print", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("void")->value.object), {Parameter(Type(Types->Get("string")->value.object), "value", optional<Node*>(), None)}, print)), Qualifier()) },
+        { "input", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("string")->value.object), {}, input)), Qualifier()) },
+        { "random", Variable(shared_ptr<Object>(new FunctionObject(Type(Types->Get("int")->value.object), {Parameter(Type(Types->Get("int")->value.object), "seed", optional<Node*>(random_default_arg), None)}, random)), Qualifier()) },
     };
 
     return functions;
 }
 
-Member CreateMethod(shared_ptr<Object> definition, vector<Parameter> parameters, function<shared_ptr<Object>(shared_ptr<Environment>)> function)
+Member CreateMethod(shared_ptr<Object> definition, vector<Parameter> parameters, NativeFunction function)
 {
     return Member(shared_ptr<Object>(new FunctionObject(Type(definition), parameters, function)), Qualifier());
 }
 
 void CreateIntMethods()
 {
-    shared_ptr<Object> intDefinition = Types->Get("int")->object;
+    shared_ptr<Object> intDefinition = Types->Get("int")->value.object;
     TypeDefinitionObject *rawIntDefinition = (TypeDefinitionObject*)intDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(intDefinition), "other", optional<Node*>(), None)};
 
-    auto powFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(pow(((IntObject*)env->Get("this")->object.get())->value, ((IntObject*)env->Get("other")->object.get())->value)));
+    auto powFunction = [] (const Value *arguments, int) {
+        return Value((int)(pow(arguments[0].int_value, arguments[1].int_value)));
     };
     rawIntDefinition->members.insert({ "pow", CreateMethod(intDefinition, parameters, powFunction) });
 
-    auto negativeFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(-((IntObject*)env->Get("this")->object.get())->value));
+    auto negativeFunction = [] (const Value *arguments, int) {
+        return Value((int)(-arguments[0].int_value));
     };
     rawIntDefinition->members.insert({ "negative", CreateMethod(intDefinition, {}, negativeFunction) });
 
-    auto positiveFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(+((IntObject*)env->Get("this")->object.get())->value));
+    auto positiveFunction = [] (const Value *arguments, int) {
+        return Value((int)(+arguments[0].int_value));
     };
     rawIntDefinition->members.insert({ "positive", CreateMethod(intDefinition, {}, positiveFunction) });
 
-    auto multiplyFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(((IntObject*)env->Get("this")->object.get())->value * ((IntObject*)env->Get("other")->object.get())->value));
+    auto multiplyFunction = [] (const Value *arguments, int) {
+        return Value((int)(arguments[0].int_value * arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "multiply", CreateMethod(intDefinition, parameters, multiplyFunction) });
 
-    auto divideFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject((double)(((IntObject*)env->Get("this")->object.get())->value) / (double)(((IntObject*)env->Get("other")->object.get())->value)));
+    auto divideFunction = [] (const Value *arguments, int) {
+        return Value((float)((double)(arguments[0].int_value) / (double)(arguments[1].int_value)));
     };
     rawIntDefinition->members.insert({ "divide", CreateMethod(intDefinition, parameters, divideFunction) });
 
-    auto intDivideFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(((IntObject*)env->Get("this")->object.get())->value / ((IntObject*)env->Get("other")->object.get())->value));
+    auto intDivideFunction = [] (const Value *arguments, int) {
+        return Value((int)(arguments[0].int_value / arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "int_divide", CreateMethod(intDefinition, parameters, intDivideFunction) });
 
-    auto moduloFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(((IntObject*)env->Get("this")->object.get())->value % ((IntObject*)env->Get("other")->object.get())->value));
+    auto moduloFunction = [] (const Value *arguments, int) {
+        return Value((int)(arguments[0].int_value % arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "modulo", CreateMethod(intDefinition, parameters, moduloFunction) });
 
-    auto addFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(((IntObject*)env->Get("this")->object.get())->value + ((IntObject*)env->Get("other")->object.get())->value));
+    auto addFunction = [] (const Value *arguments, int) {
+        return Value((int)(arguments[0].int_value + arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "add", CreateMethod(intDefinition, parameters, addFunction) });
 
-    auto subtractFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new IntObject(((IntObject*)env->Get("this")->object.get())->value - ((IntObject*)env->Get("other")->object.get())->value));
+    auto subtractFunction = [] (const Value *arguments, int) {
+        return Value((int)(arguments[0].int_value - arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "subtract", CreateMethod(intDefinition, parameters, subtractFunction) });
 
-    auto equalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value == ((IntObject*)env->Get("other")->object.get())->value));
+    auto equalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value == arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "equality", CreateMethod(intDefinition, parameters, equalityFunction) });
 
-    auto inequalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value != ((IntObject*)env->Get("other")->object.get())->value));
+    auto inequalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value != arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "inequality", CreateMethod(intDefinition, parameters, inequalityFunction) });
 
-    auto greaterEqualFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value >= ((IntObject*)env->Get("other")->object.get())->value));
+    auto greaterEqualFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value >= arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "greater_equal", CreateMethod(intDefinition, parameters, greaterEqualFunction) });
 
-    auto lessEqualFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value <= ((IntObject*)env->Get("other")->object.get())->value));
+    auto lessEqualFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value <= arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "less_equal", CreateMethod(intDefinition, parameters, lessEqualFunction) });
 
-    auto greaterFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value > ((IntObject*)env->Get("other")->object.get())->value));
+    auto greaterFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value > arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "greater", CreateMethod(intDefinition, parameters, greaterFunction) });
 
-    auto lessFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((IntObject*)env->Get("this")->object.get())->value < ((IntObject*)env->Get("other")->object.get())->value));
+    auto lessFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].int_value < arguments[1].int_value));
     };
     rawIntDefinition->members.insert({ "less", CreateMethod(intDefinition, parameters, lessFunction) });
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((IntObject*)env->Get("this")->object.get())->value = ((IntObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    // Assignment methods return the new value, the interpreter stores it back into the assigned variable
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[1].int_value);
     };
     rawIntDefinition->members.insert({ "assignment", CreateMethod(intDefinition, parameters, assignmentFunction) });
 
-    auto addAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((IntObject*)env->Get("this")->object.get())->value += ((IntObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto addAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].int_value + arguments[1].int_value);
     };
     rawIntDefinition->members.insert({ "add_assignment", CreateMethod(intDefinition, parameters, addAssignmentFunction) });
 
-    auto subtractAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((IntObject*)env->Get("this")->object.get())->value -= ((IntObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto subtractAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].int_value - arguments[1].int_value);
     };
     rawIntDefinition->members.insert({ "subtract_assignment", CreateMethod(intDefinition, parameters, subtractAssignmentFunction) });
 
-    auto multiplyAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((IntObject*)env->Get("this")->object.get())->value *= ((IntObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto multiplyAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].int_value * arguments[1].int_value);
     };
     rawIntDefinition->members.insert({ "multiply_assignment", CreateMethod(intDefinition, parameters, multiplyAssignmentFunction) });
 
-    auto divideAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((IntObject*)env->Get("this")->object.get())->value /= ((IntObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto divideAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].int_value / arguments[1].int_value);
     };
     rawIntDefinition->members.insert({ "divide_assignment", CreateMethod(intDefinition, parameters, divideAssignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(to_string(((IntObject*)env->Get("this")->object.get())->value)));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(to_string(arguments[0].int_value))));
     };
     rawIntDefinition->members.insert({ "to_string", CreateMethod(intDefinition, {}, toStringFunction) });
 }
 
 void CreateFloatMethods()
 {
-    shared_ptr<Object> floatDefinition = Types->Get("float")->object;
+    shared_ptr<Object> floatDefinition = Types->Get("float")->value.object;
     TypeDefinitionObject *rawFloatDefinition = (TypeDefinitionObject*)floatDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(floatDefinition), "other", optional<Node*>(), None)};
 
-    auto powFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(pow(((FloatObject*)env->Get("this")->object.get())->value, ((FloatObject*)env->Get("other")->object.get())->value)));
+    auto powFunction = [] (const Value *arguments, int) {
+        return Value((float)(pow(arguments[0].float_value, arguments[1].float_value)));
     };
     rawFloatDefinition->members.insert({ "pow", CreateMethod(floatDefinition, parameters, powFunction) });
 
-    auto negativeFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(-((FloatObject*)env->Get("this")->object.get())->value));
+    auto negativeFunction = [] (const Value *arguments, int) {
+        return Value((float)(-arguments[0].float_value));
     };
     rawFloatDefinition->members.insert({ "negative", CreateMethod(floatDefinition, {}, negativeFunction) });
 
-    auto positiveFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(+((FloatObject*)env->Get("this")->object.get())->value));
+    auto positiveFunction = [] (const Value *arguments, int) {
+        return Value((float)(+arguments[0].float_value));
     };
     rawFloatDefinition->members.insert({ "positive", CreateMethod(floatDefinition, {}, positiveFunction) });
 
-    auto multiplyFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(((FloatObject*)env->Get("this")->object.get())->value * ((FloatObject*)env->Get("other")->object.get())->value));
+    auto multiplyFunction = [] (const Value *arguments, int) {
+        return Value((float)(arguments[0].float_value * arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "multiply", CreateMethod(floatDefinition, parameters, multiplyFunction) });
 
-    auto divideFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(((FloatObject*)env->Get("this")->object.get())->value / ((FloatObject*)env->Get("other")->object.get())->value));
+    auto divideFunction = [] (const Value *arguments, int) {
+        return Value((float)(arguments[0].float_value / arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "divide", CreateMethod(floatDefinition, parameters, divideFunction) });
 
-    auto floatDivideFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject((int)(((FloatObject*)env->Get("this")->object.get())->value) / (int)(((FloatObject*)env->Get("other")->object.get())->value)));
+    auto floatDivideFunction = [] (const Value *arguments, int) {
+        return Value((float)((int)(arguments[0].float_value) / (int)(arguments[1].float_value)));
     };
     rawFloatDefinition->members.insert({ "integer_divide", CreateMethod(floatDefinition, parameters, floatDivideFunction) });
 
-    auto moduloFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject((int)(((FloatObject*)env->Get("this")->object.get())->value) % (int)(((FloatObject*)env->Get("other")->object.get())->value)));
+    auto moduloFunction = [] (const Value *arguments, int) {
+        return Value((float)((int)(arguments[0].float_value) % (int)(arguments[1].float_value)));
     };
     rawFloatDefinition->members.insert({ "modulo", CreateMethod(floatDefinition, parameters, moduloFunction) });
 
-    auto addFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(((FloatObject*)env->Get("this")->object.get())->value + ((FloatObject*)env->Get("other")->object.get())->value));
+    auto addFunction = [] (const Value *arguments, int) {
+        return Value((float)(arguments[0].float_value + arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "add", CreateMethod(floatDefinition, parameters, addFunction) });
 
-    auto subtractFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new FloatObject(((FloatObject*)env->Get("this")->object.get())->value - ((FloatObject*)env->Get("other")->object.get())->value));
+    auto subtractFunction = [] (const Value *arguments, int) {
+        return Value((float)(arguments[0].float_value - arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "subtract", CreateMethod(floatDefinition, parameters, subtractFunction) });
 
-    auto equalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value == ((FloatObject*)env->Get("other")->object.get())->value));
+    auto equalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value == arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "equality", CreateMethod(floatDefinition, parameters, equalityFunction) });
 
-    auto inequalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value != ((FloatObject*)env->Get("other")->object.get())->value));
+    auto inequalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value != arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "inequality", CreateMethod(floatDefinition, parameters, inequalityFunction) });
 
-    auto greaterEqualFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value >= ((FloatObject*)env->Get("other")->object.get())->value));
+    auto greaterEqualFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value >= arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "greater_equal", CreateMethod(floatDefinition, parameters, greaterEqualFunction) });
 
-    auto lessEqualFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value <= ((FloatObject*)env->Get("other")->object.get())->value));
+    auto lessEqualFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value <= arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "less_equal", CreateMethod(floatDefinition, parameters, lessEqualFunction) });
 
-    auto greaterFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value > ((FloatObject*)env->Get("other")->object.get())->value));
+    auto greaterFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value > arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "greater", CreateMethod(floatDefinition, parameters, greaterFunction) });
 
-    auto lessFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((FloatObject*)env->Get("this")->object.get())->value < ((FloatObject*)env->Get("other")->object.get())->value));
+    auto lessFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].float_value < arguments[1].float_value));
     };
     rawFloatDefinition->members.insert({ "less", CreateMethod(floatDefinition, parameters, lessFunction) });
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FloatObject*)env->Get("this")->object.get())->value = ((FloatObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[1].float_value);
     };
     rawFloatDefinition->members.insert({ "assignment", CreateMethod(floatDefinition, parameters, assignmentFunction) });
 
-    auto addAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FloatObject*)env->Get("this")->object.get())->value += ((FloatObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto addAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].float_value + arguments[1].float_value);
     };
     rawFloatDefinition->members.insert({ "add_assignment", CreateMethod(floatDefinition, parameters, addAssignmentFunction) });
 
-    auto subtractAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FloatObject*)env->Get("this")->object.get())->value -= ((FloatObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto subtractAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].float_value - arguments[1].float_value);
     };
     rawFloatDefinition->members.insert({ "subtract_assignment", CreateMethod(floatDefinition, parameters, subtractAssignmentFunction) });
 
-    auto multiplyAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FloatObject*)env->Get("this")->object.get())->value *= ((FloatObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto multiplyAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].float_value * arguments[1].float_value);
     };
     rawFloatDefinition->members.insert({ "multiply_assignment", CreateMethod(floatDefinition, parameters, multiplyAssignmentFunction) });
 
-    auto divideAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FloatObject*)env->Get("this")->object.get())->value /= ((FloatObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto divideAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[0].float_value / arguments[1].float_value);
     };
     rawFloatDefinition->members.insert({ "divide_assignment", CreateMethod(floatDefinition, parameters, divideAssignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(to_string(((FloatObject*)env->Get("this")->object.get())->value)));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(to_string(arguments[0].float_value))));
     };
     rawFloatDefinition->members.insert({ "to_string", CreateMethod(floatDefinition, {}, toStringFunction) });
 }
 
 void CreateBoolMethods()
 {
-    shared_ptr<Object> boolDefinition = Types->Get("bool")->object;
+    shared_ptr<Object> boolDefinition = Types->Get("bool")->value.object;
     TypeDefinitionObject *rawBoolDefinition = (TypeDefinitionObject*)boolDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(boolDefinition), "other", optional<Node*>(), None)};
 
-    auto notFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(!(((BoolObject*)env->Get("this")->object.get())->value)));
+    auto notFunction = [] (const Value *arguments, int) {
+        return Value((bool)(!(arguments[0].bool_value)));
     };
     rawBoolDefinition->members.insert({ "not", CreateMethod(boolDefinition, {}, notFunction) });
 
-    auto equalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((BoolObject*)env->Get("this")->object.get())->value == ((BoolObject*)env->Get("other")->object.get())->value));
+    auto equalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].bool_value == arguments[1].bool_value));
     };
     rawBoolDefinition->members.insert({ "equality", CreateMethod(boolDefinition, parameters, equalityFunction) });
 
-    auto inequalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((BoolObject*)env->Get("this")->object.get())->value != ((BoolObject*)env->Get("other")->object.get())->value));
+    auto inequalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].bool_value != arguments[1].bool_value));
     };
     rawBoolDefinition->members.insert({ "inequality", CreateMethod(boolDefinition, parameters, inequalityFunction) });
 
-    auto andFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((BoolObject*)env->Get("this")->object.get())->value && ((BoolObject*)env->Get("other")->object.get())->value));
+    auto andFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].bool_value && arguments[1].bool_value));
     };
     rawBoolDefinition->members.insert({ "and", CreateMethod(boolDefinition, parameters, andFunction) });
 
-    auto orFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((BoolObject*)env->Get("this")->object.get())->value || ((BoolObject*)env->Get("other")->object.get())->value));
+    auto orFunction = [] (const Value *arguments, int) {
+        return Value((bool)(arguments[0].bool_value || arguments[1].bool_value));
     };
     rawBoolDefinition->members.insert({ "or", CreateMethod(boolDefinition, parameters, orFunction) });
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((BoolObject*)env->Get("this")->object.get())->value = ((BoolObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return Value(arguments[1].bool_value);
     };
     rawBoolDefinition->members.insert({ "assignment", CreateMethod(boolDefinition, parameters, assignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(to_string(((BoolObject*)env->Get("this")->object.get())->value)));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(to_string(arguments[0].bool_value))));
     };
     rawBoolDefinition->members.insert({ "to_string", CreateMethod(boolDefinition, {}, toStringFunction) });
 }
 
 void CreateStringMethods()
 {
-    shared_ptr<Object> stringDefinition = Types->Get("string")->object;
+    shared_ptr<Object> stringDefinition = Types->Get("string")->value.object;
     TypeDefinitionObject *rawStringDefinition = (TypeDefinitionObject*)stringDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(stringDefinition), "other", optional<Node*>(), None)};
 
-    auto addFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new StringObject(((StringObject*)env->Get("this")->object.get())->value + ((StringObject*)env->Get("other")->object.get())->value));
+    auto addFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>( new StringObject(((StringObject*)arguments[0].object.get())->value + ((StringObject*)arguments[1].object.get())->value)));
     };
     rawStringDefinition->members.insert({ "add", CreateMethod(stringDefinition, parameters, addFunction) });
 
-    auto equalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((StringObject*)env->Get("this")->object.get())->value == ((StringObject*)env->Get("other")->object.get())->value));
+    auto equalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(((StringObject*)arguments[0].object.get())->value == ((StringObject*)arguments[1].object.get())->value));
     };
     rawStringDefinition->members.insert({ "equality", CreateMethod(stringDefinition, parameters, equalityFunction) });
 
-    auto inequalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((StringObject*)env->Get("this")->object.get())->value != ((StringObject*)env->Get("other")->object.get())->value));
+    auto inequalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(((StringObject*)arguments[0].object.get())->value != ((StringObject*)arguments[1].object.get())->value));
     };
     rawStringDefinition->members.insert({ "inequality", CreateMethod(stringDefinition, parameters, inequalityFunction) });
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((StringObject*)env->Get("this")->object.get())->value = ((StringObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return arguments[1];
     };
     rawStringDefinition->members.insert({ "assignment", CreateMethod(stringDefinition, parameters, assignmentFunction) });
 
-    auto addAssignmentFunction = [] (shared_ptr<Environment> env) {
-        ((StringObject*)env->Get("this")->object.get())->value += ((StringObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    // Always builds a new string, 'this' may be a literal constant shared with other variables
+    auto addAssignmentFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(((StringObject*)arguments[0].object.get())->value + ((StringObject*)arguments[1].object.get())->value)));
     };
     rawStringDefinition->members.insert({ "add_assignment", CreateMethod(stringDefinition, parameters, addAssignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(((StringObject*)env->Get("this")->object.get())->value));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(((StringObject*)arguments[0].object.get())->value)));
     };
     rawStringDefinition->members.insert({ "to_string", CreateMethod(stringDefinition, {}, toStringFunction) });
 }
 
 void CreateTypeMethods()
 {
-    shared_ptr<Object> typeDefinition = Types->Get("Type")->object;
+    shared_ptr<Object> typeDefinition = Types->Get("Type")->value.object;
     TypeDefinitionObject *rawTypeDefinition = (TypeDefinitionObject*)typeDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(typeDefinition), "other", optional<Node*>(), None)};
 
-    auto equalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((TypeObject*)env->Get("this")->object.get())->value == ((TypeObject*)env->Get("other")->object.get())->value));
+    auto equalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(((TypeObject*)arguments[0].object.get())->value == ((TypeObject*)arguments[1].object.get())->value));
     };
     rawTypeDefinition->members.insert({ "equality", CreateMethod(typeDefinition, parameters, equalityFunction) });
 
-    auto inequalityFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>( new BoolObject(((TypeObject*)env->Get("this")->object.get())->value != ((TypeObject*)env->Get("other")->object.get())->value));
+    auto inequalityFunction = [] (const Value *arguments, int) {
+        return Value((bool)(((TypeObject*)arguments[0].object.get())->value != ((TypeObject*)arguments[1].object.get())->value));
     };
     rawTypeDefinition->members.insert({ "inequality", CreateMethod(typeDefinition, parameters, inequalityFunction) });
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((TypeObject*)env->Get("this")->object.get())->value = ((TypeObject*)env->Get("other")->object.get())->value;
-        return shared_ptr<Object>(new VoidObject());
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return arguments[1];
     };
     rawTypeDefinition->members.insert({ "assignment", CreateMethod(typeDefinition, parameters, assignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(((TypeObject*)env->Get("this")->object.get())->value.type_definition->to_string()));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(((TypeObject*)arguments[0].object.get())->value.type_definition->to_string())));
     };
     rawTypeDefinition->members.insert({ "to_string", CreateMethod(typeDefinition, {}, toStringFunction) });
 }
 
 void CreateFunctionMethods()
 {
-    shared_ptr<Object> functionDefinition = Types->Get("Function")->object;
+    shared_ptr<Object> functionDefinition = Types->Get("Function")->value.object;
     TypeDefinitionObject *rawFunctionDefinition = (TypeDefinitionObject*)functionDefinition.get();
 
     vector<Parameter> parameters = {Parameter(Type(functionDefinition), "other", optional<Node*>(), None)};
 
-    auto assignmentFunction = [] (shared_ptr<Environment> env) {
-        ((FunctionObject*)env->Get("this")->object.get())->return_type = ((FunctionObject*)env->Get("other")->object.get())->return_type;
-        ((FunctionObject*)env->Get("this")->object.get())->parameters = ((FunctionObject*)env->Get("other")->object.get())->parameters;
-        ((FunctionObject*)env->Get("this")->object.get())->body = ((FunctionObject*)env->Get("other")->object.get())->body;
-        return shared_ptr<Object>(new VoidObject());
+    auto assignmentFunction = [] (const Value *arguments, int) {
+        return arguments[1];
     };
     rawFunctionDefinition->members.insert({ "assignment", CreateMethod(functionDefinition, parameters, assignmentFunction) });
 
-    auto toStringFunction = [] (shared_ptr<Environment> env) {
-        return shared_ptr<Object>(new StringObject(((IntObject*)env->Get("this")->object.get())->to_string()));
+    auto toStringFunction = [] (const Value *arguments, int) {
+        return Value(shared_ptr<Object>(new StringObject(arguments[0].to_string())));
     };
     rawFunctionDefinition->members.insert({ "to_string", CreateMethod(functionDefinition, {}, toStringFunction) });
 }
\ No newline at end of file
@@ -16,15 +16,27 @@
 
 class Environment;
 class Object;
+class Chunk;
 
 enum RETURN_REASON
 {
     ReturnStatement,
+    TailCallStatement,
     BreakStatement,
     ContinueStatement,
     EndOfAST,
 };
 
+enum VALUE_TAG
+{
+    EmptyValue,
+    VoidValue,
+    IntValue,
+    FloatValue,
+    BoolValue,
+    ObjectValue,
+};
+
 class Type
 {
     public:
@@ -53,13 +65,79 @@ class Qualifier
         friend std::ostream &operator<<(std::ostream &os, const Qualifier &qualifier);
 };
 
+enum ALLOCATION_CLASS
+{
+    StringAllocation,
+    TypeAllocation,
+    TypeDefinitionAllocation,
+    InstanceAllocation,
+    FunctionAllocation,
+    EnvironmentAllocation,
+};
+
+const int Allocation_Classes = 6;
+
+// Blocks are handed out in multiples of Size_Class_Step bytes, larger requests go to the global heap
+const int Size_Class_Step = 16;
+const int Size_Classes = 16;
+const int Slab_Size = 64 * 1024;
+
+// Building with -DPLUTO_SYSTEM_ALLOCATOR sends every block to ::operator new, so memory checkers see each object on its own
+#ifdef PLUTO_SYSTEM_ALLOCATOR
+const bool Slab_Allocation = false;
+#else
+const bool Slab_Allocation = true;
+#endif
+
+// Objects and environments are carved from fixed-size slabs, freed blocks are reused by the next allocation of their size class.
+// Under AddressSanitizer free blocks stay poisoned until they are handed out again, so a use after free is still reported.
+class SlabAllocator
+{
+    public:
+        void *free_lists[Size_Classes];
+        char *cursor;
+        char *limit;
+
+        size_t slab_bytes;
+        long long live_blocks[Size_Classes];
+        long long live_objects[Allocation_Classes];
+
+        void *Allocate(size_t size);
+
+        void Free(void *pointer, size_t size);
+
+        friend std::ostream &operator<<(std::ostream &os, SlabAllocator &allocator);
+};
+
+// One allocator serves the whole process rather than each interpreter, because objects outlive the interpreter that made them:
+// builtin types live in globals, functions are cached on the AST, and main runs the program on a thread of its own and releases the rest at exit.
+// The interpreter only ever runs on one thread at a time, so the allocator takes no locks.
+// Slabs are never returned, so objects released during exit still have somewhere to go
+extern SlabAllocator DefaultAllocator;
+
+enum OBJECT_KIND : unsigned char
+{
+    StringObjectKind,
+    TypeObjectKind,
+    TypeDefinitionObjectKind,
+    ClassInstanceObjectKind,
+    FunctionObjectKind,
+    ErrorObjectKind,
+};
+
 class Object
 {
     public:
+        // Set by every subclass constructor so type tests are a single compare instead of a dynamic_cast
+        OBJECT_KIND kind;
         Type type;
 
         Object();
 
+        static void *operator new(size_t size);
+
+        static void operator delete(void *pointer, size_t size);
+
         virtual std::string to_string() = 0;
 
         virtual ~Object();
@@ -67,13 +145,53 @@ class Object
         friend std::ostream &operator<<(std::ostream &os, Object &object);
 };
 
-class Member
+// Checked downcast on the kind tag, NULL when the object is missing or of another kind
+template <typename T>
+T *ObjectCast(Object *object)
+{
+    return object && object->kind == T::Kind ? (T*)object : NULL;
+}
+
+// int, float, bool and void are stored inline, everything else is boxed in an Object
+class Value
 {
     public:
+        VALUE_TAG tag;
+        union
+        {
+            int int_value;
+            float float_value;
+            bool bool_value;
+        };
         std::shared_ptr<Object> object;
+
+        Value();
+
+        Value(int value);
+
+        Value(float value);
+
+        Value(bool value);
+
+        Value(std::shared_ptr<Object> object);
+
+        Type GetType() const;
+
+        // Identity of the type without taking a reference, for comparisons on hot paths
+        Object *GetTypeDefinition() const;
+
+        std::string to_string() const;
+
+        friend std::ostream &operator<<(std::ostream &os, const Value &value);
+};
+
+class Member
+{
+    public:
+        Value value;
         Qualifier qualifiers;
 
-        Member(std::shared_ptr<Object> object, Qualifier qualifiers);
+        Member(Value value, Qualifier qualifiers);
 
         friend std::ostream &operator<<(std::ostream &os, const Member &member);
 };
@@ -84,6 +202,8 @@ class Parameter
         Type type;
         std::string name;
         std::optional<Node*> default_argument;
+        // Constant default arguments are evaluated on first use and reused by later calls
+        std::optional<Value> default_value;
         ARGUMENT_EXPANSION argument_expansion;
 
         Parameter(Type type, std::string name, std::optional<Node*> default_argument, ARGUMENT_EXPANSION argument_expansion);
@@ -94,80 +214,95 @@ class Parameter
 class Variable
 {
     public:
-        std::shared_ptr<Object> object;
+        Value value;
         Qualifier qualifiers;
 
-        Variable(std::shared_ptr<Object> object, Qualifier qualifiers);
+        // An empty variable marks a slot that has not been declared yet
+        Variable();
+
+        Variable(Value value, Qualifier qualifiers);
 
         friend std::ostream &operator<<(std::ostream &os, const Variable &variable);
 };
 
+// Names of the slots of a scope, worked out once and shared by every environment made for it
+using SlotNames = std::map<std::string, int>;
+
 class Environment
 {
     public:
         std::shared_ptr<Environment> parent_environment;
-        std::map<std::string, Variable> variables;
+        std::vector<Variable> slots;
+        // Names added at runtime, the names laid out ahead of time are in slot_names
+        std::map<std::string, int> names;
+        std::shared_ptr<const SlotNames> slot_names;
+        // Set on method and constructor environments, whose attribute names resolve to the slots of this instance in place
+        std::shared_ptr<Object> instance;
+        // Set when a class is defined in this scope, the visible classes change once the scope is gone
+        bool defines_classes;
 
         Environment(std::shared_ptr<Environment> parent_environment, std::map<std::string, Variable> variables);
 
-        std::optional<Variable> Get(std::string name);
+        Environment(std::shared_ptr<Environment> parent_environment, int slot_count);
 
-        void Add(std::string name, Variable variable);
+        static void *operator new(size_t size);
 
-        friend std::ostream &operator<<(std::ostream &os, const Environment &environment);
-};
+        static void operator delete(void *pointer, size_t size);
 
-class Call
-{
-    public:
-        std::string node_type;
-        std::optional<Type> return_type;
+        // Name based lookup, used when an identifier could not be resolved to a slot
+        Variable *Get(std::string name);
 
-        Call(std::string node_type, std::optional<Type> return_type);
+        // Returns NULL when the slot has not been declared yet
+        Variable *Get(int depth, int slot);
 
-        friend std::ostream &operator<<(std::ostream &os, const Call &call);
-};
+        Variable *Find(std::string name, int depth, int slot);
 
-class IntObject : public Object
-{
-    public:
-        int value;
+        // Looks at this scope alone, names of enclosing scopes and callers may be shadowed
+        bool Declares(std::string name);
 
-        IntObject(int value);
+        void Add(std::string name, Variable variable);
 
-        std::string to_string();
+        void Set(int slot, std::string name, Variable variable);
 
-        ~IntObject();
-};
+        std::map<std::string, Variable> Variables() const;
 
-class FloatObject : public Object
-{
-    public:
-        float value;
+        friend std::ostream &operator<<(std::ostream &os, const Environment &environment);
 
-        FloatObject(float value);
+        ~Environment();
+};
 
-        std::string to_string();
+// Deepest nesting of function calls a script may reach, set from the command line
+extern int Max_Call_Depth;
 
-        ~FloatObject();
-};
+// Advanced whenever the set of visible classes may have changed, which invalidates the types cached on TypeExpressions
+extern int Type_Generation;
 
-class BoolObject : public Object
+// Calls live on the C++ stack of the interpreter and link to the enclosing call, so entering one never copies the stack
+class Call
 {
     public:
-        bool value;
-
-        BoolObject(bool value);
+        NODE_KIND node_kind;
+        std::optional<Type> return_type;
+        Node *node;
+        Call *parent;
+        // Number of function calls in the chain up to and including this one
+        int depth;
+        // A return in tail position leaves the next call here for the enclosing function call to run in place
+        std::shared_ptr<Object> tail_function;
+        std::vector<Variable> tail_arguments;
 
-        std::string to_string();
+        Call(NODE_KIND node_kind, std::optional<Type> return_type, Node *node = NULL, Call *parent = NULL);
 
-        ~BoolObject();
+        friend std::ostream &operator<<(std::ostream &os, const Call &call);
 };
 
 class StringObject : public Object
 {
     public:
-        std::string value;
+        static const OBJECT_KIND Kind = StringObjectKind;
+
+        // Strings are immutable so string literals can be shared, operations build a new StringObject
+        const std::string value;
 
         StringObject(std::string value);
 
@@ -179,6 +314,8 @@ class StringObject : public Object
 class TypeObject : public Object
 {
     public:
+        static const OBJECT_KIND Kind = TypeObjectKind;
+
         Type value;
 
         TypeObject(Type value);
@@ -188,11 +325,32 @@ class TypeObject : public Object
         ~TypeObject();
 };
 
+// Lays out the attributes of a class in fixed slots, every instance of the class stores its attributes in this order
+class Shape
+{
+    public:
+        std::map<std::string, int> slots;
+        std::vector<std::string> names;
+        std::vector<Qualifier> qualifiers;
+        // Attributes a new instance starts with, copied in one go
+        std::vector<Variable> defaults;
+
+        Shape();
+
+        int Add(std::string name, Member member);
+
+        // Returns -1 when the class has no attribute with this name
+        int Find(const std::string &name);
+};
+
 class TypeDefinitionObject : public Object
 {
     public:
+        static const OBJECT_KIND Kind = TypeDefinitionObjectKind;
+
         std::string name;
         std::map<std::string, Member> members;
+        Shape shape;
 
         TypeDefinitionObject(std::string name, std::map<std::string, Member> members);
 
@@ -203,48 +361,98 @@ class TypeDefinitionObject : public Object
         ~TypeDefinitionObject();
 };
 
-class ClassInstanceObject : public Object
+class ClassInstanceObject : public Object, public std::enable_shared_from_this<ClassInstanceObject>
 {
     public:
-        std::map<std::string, Member> members;
+        static const OBJECT_KIND Kind = ClassInstanceObjectKind;
+
+        // Attributes in the order given by the shape of the class, methods reach them through their environment without a copy
+        std::vector<Variable> slots;
+        // Generation and position of the instance in the heap, the index is -1 when it is not tracked
+        int heap_generation;
+        int heap_index;
+        // References held from outside the instances being collected, -1 outside of a collection
+        long gc_references;
+        bool reachable;
 
-        ClassInstanceObject(std::shared_ptr<Object> class_type, std::map<std::string, Member> members);
+        ClassInstanceObject(std::shared_ptr<Object> class_type);
+
+        Shape &GetShape();
 
         std::string to_string();
 
         ~ClassInstanceObject();
 };
 
-class FunctionObject : public Object
+// Reference counting frees acyclic garbage as soon as it is dropped, the heap finds groups of instances that only keep each other alive
+// Functions hold no environment and no value holds one, so instance slots are the only references a cycle can run through
+class Heap
 {
     public:
-        Type return_type;
-        std::vector<Parameter> parameters;
-        std::variant<std::vector<Node*>, std::function<std::shared_ptr<Object>(std::shared_ptr<Environment>)>> body;
+        // Instances created since the last collection
+        std::vector<ClassInstanceObject*> nursery;
+        // Instances that survived a collection, only scanned by full collections
+        std::vector<ClassInstanceObject*> old_generation;
+        int old_generation_limit;
 
-        FunctionObject(Type return_type, std::vector<Parameter> parameters, std::variant<std::vector<Node*>, std::function<std::shared_ptr<Object>(std::shared_ptr<Environment>)>> body);
+        int collections;
+        int full_collections;
+        long long collected;
+        double total_pause;
+        double longest_pause;
 
-        std::string to_string();
+        Heap();
 
-        ~FunctionObject();
+        ~Heap();
+
+        void Track(ClassInstanceObject *object);
+
+        void Untrack(ClassInstanceObject *object);
+
+        int Collect(bool full);
+
+        size_t Size();
+
+        friend std::ostream &operator<<(std::ostream &os, Heap &heap);
 };
 
-class VoidObject : public Object
+// Instances still alive when a heap is destroyed, as at exit, are detached from it and later freed by reference counting alone
+extern Heap DefaultHeap;
+
+std::shared_ptr<Object> CreateInstance(std::shared_ptr<Object> class_type);
+
+// Builtins receive their arguments as a contiguous span, methods get the instance as the first argument
+using NativeFunction = Value (*)(const Value *arguments, int count);
+
+class FunctionObject : public Object
 {
     public:
-        VoidObject();
+        static const OBJECT_KIND Kind = FunctionObjectKind;
+
+        Type return_type;
+        std::vector<Parameter> parameters;
+        // Arguments take the first slots of a call environment in parameter order
+        std::shared_ptr<const SlotNames> parameter_names;
+        std::variant<std::vector<Node*>, NativeFunction> body;
+        std::shared_ptr<Chunk> chunk;
+
+        FunctionObject(Type return_type, std::vector<Parameter> parameters, std::variant<std::vector<Node*>, NativeFunction> body);
 
         std::string to_string();
 
-        ~VoidObject();
+        ~FunctionObject();
 };
 
 class ErrorObject : public Object
 {
     public:
+        static const OBJECT_KIND Kind = ErrorObjectKind;
+
         int start;
         int end;
         Error error;
+        // Active script calls when the error was thrown, innermost first
+        std::vector<TraceFrame> stack_trace;
 
         ErrorObject(int start, int end, Error error);
 
@@ -255,15 +463,17 @@ class ErrorObject : public Object
 
 std::map<std::string, Member> VariablesToMembers(std::map<std::string, Variable> variables);
 
-std::map<std::string, Variable> MembersToVariables(std::map<std::string, Member> members);
-
 std::shared_ptr<Environment> InitialiseInterpreterData();
 
 extern std::shared_ptr<Environment> Types;
 
+extern std::shared_ptr<Object> IntDefinition;
+extern std::shared_ptr<Object> FloatDefinition;
+extern std::shared_ptr<Object> BoolDefinition;
+
 std::map<std::string, Variable> CreateBuiltinFunctions();
 
-Member CreateMethod(std::shared_ptr<Object> definition, std::vector<Parameter> parameters, std::function<std::shared_ptr<Object>(std::shared_ptr<Environment>)> function);
+Member CreateMethod(std::shared_ptr<Object> definition, std::vector<Parameter> parameters, NativeFunction function);
 
 void CreateIntMethods();
 void CreateFloatMethods();
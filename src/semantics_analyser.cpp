@@ -1,6 +1,5 @@
 #include <string>
 #include <vector>
-#include <regex>
 
 #include "semantics_analyser.hpp"
 #include "token.hpp"
@@ -19,36 +18,27 @@ vector<Node*> AnalyseSemantics(vector<Node*> AST, vector<Node*> call_stack)
 
     bool semicolon_needed = false;
 
-    if (AST[AST.size() - 1]->type != "ClassDefinition" && AST[AST.size() - 1]->type != "IfStatement" && AST[AST.size() - 1]->type != "SwitchStatement" &&
-        AST[AST.size() - 1]->type != "ForLoop" && AST[AST.size() - 1]->type != "ForEachLoop" && AST[AST.size() - 1]->type != "WhileLoop" && AST[AST.size() - 1]->type != "StatementEnd")
+    if (NeedsStatementEnd(AST[AST.size() - 1]))
     {
         ThrowError(AST[AST.size() - 1]->start, AST[AST.size() - 1]->end, Error {SyntaxError, "Missing ending ;"});
     }
 
     for (Node *node : AST)
     {
-        if (node->type != "StatementEnd" && !semicolon_needed)
+        if (node->kind != StatementEndNode && !semicolon_needed)
         {
-            if (node->type == "ClassDefinition" || node->type == "IfStatement" || node->type == "SwitchStatement" ||
-                node->type == "ForLoop" || node->type == "ForEachLoop" || node->type == "WhileLoop")
-            {
-                semicolon_needed = false;
-            }
-            else
-            {
-                semicolon_needed = true;
-            }
+            semicolon_needed = NeedsStatementEnd(node);
         }
-        else if (node->type != "StatementEnd" && semicolon_needed)
+        else if (node->kind != StatementEndNode && semicolon_needed)
         {
             ThrowError(node->start, node->end, Error {SyntaxError, "Missing ending ;"});
         }
-        else if (node->type == "StatementEnd" && semicolon_needed)
+        else if (node->kind == StatementEndNode && semicolon_needed)
         {
             semicolon_needed = false;
         }
 
-        if (node->type != "StatementEnd")
+        if (node->kind != StatementEndNode)
         {
             new_AST.push_back(node);
         }
@@ -69,27 +59,51 @@ void CheckStatement(Node *statement, vector<Node*> call_stack)
         return;
     }
 
-    if (statement->type == "ParameterExpression" || statement->type == "QualifierExpression")
+    if (StackExhausted())
     {
-        ThrowError(statement->start, statement->end, Error {SyntaxError, "Invalid expression"});
+        ThrowError(statement->start, statement->end, Error {RecursionError, "Maximum nesting depth exceeded"});
     }
 
-    if (statement->type == "Return" && !InCallStack(call_stack, "CodeBlock"))
+    switch (statement->kind)
     {
-        ThrowError(statement->start, statement->end, Error {SyntaxError, "Return outside function"});
-    }
-    else if ((statement->type == "Break" || statement->type == "Continue") &&
-              !InCallStack(call_stack, "ForLoop") && !InCallStack(call_stack, "ForEachLoop") && !InCallStack(call_stack, "WhileLoop") &&
-              (!InCallStack(call_stack, "FunctionCall") || (CallStackPosition(call_stack, "ForLoop") < CallStackPosition(call_stack, "CodeBlock")) ||
-              (CallStackPosition(call_stack, "ForEachLoop") < CallStackPosition(call_stack, "CodeBlock")) || (CallStackPosition(call_stack, "WhileLoop") < CallStackPosition(call_stack, "CodeBlock"))))
-    {
-        if (statement->type == "Break")
+        case ParameterExpressionNode:
+        case QualifierExpressionNode:
         {
-            ThrowError(statement->start, statement->end, Error {SyntaxError, "Break outside loop"});
+            ThrowError(statement->start, statement->end, Error {SyntaxError, "Invalid expression"});
+
+            break;
         }
-        else if (statement->type == "Continue")
+        case ReturnNode:
         {
-            ThrowError(statement->start, statement->end, Error {SyntaxError, "Continue outside loop"});
+            if (!InCallStack(call_stack, CodeBlockNode))
+            {
+                ThrowError(statement->start, statement->end, Error {SyntaxError, "Return outside function"});
+            }
+
+            break;
+        }
+        case BreakNode:
+        case ContinueNode:
+        {
+            if (!InCallStack(call_stack, ForLoopNode) && !InCallStack(call_stack, ForEachLoopNode) && !InCallStack(call_stack, WhileLoopNode) &&
+                (!InCallStack(call_stack, FunctionCallNode) || (CallStackPosition(call_stack, ForLoopNode) < CallStackPosition(call_stack, CodeBlockNode)) ||
+                (CallStackPosition(call_stack, ForEachLoopNode) < CallStackPosition(call_stack, CodeBlockNode)) || (CallStackPosition(call_stack, WhileLoopNode) < CallStackPosition(call_stack, CodeBlockNode))))
+            {
+                if (statement->kind == BreakNode)
+                {
+                    ThrowError(statement->start, statement->end, Error {SyntaxError, "Break outside loop"});
+                }
+                else
+                {
+                    ThrowError(statement->start, statement->end, Error {SyntaxError, "Continue outside loop"});
+                }
+            }
+
+            break;
+        }
+        default:
+        {
+            break;
         }
     }
 
@@ -103,25 +117,126 @@ void CheckExpression(Node *expression, vector<Node*> call_stack)
         return;
     }
 
-    if (
-        expression->type == "ParameterExpression" || expression->type == "QualifierExpression" || expression->type == "DeclareVariable" ||
-        expression->type == "ClassDefinition" || expression->type == "IfStatement" || expression->type == "SwitchStatement" ||
-        expression->type == "ForLoop" || expression->type == "ForEachLoop" || expression->type == "WhileLoop" ||
-        expression->type == "Return" || expression->type == "Break" || expression->type == "Continue" ||
-        expression->type == "StatementEnd"
-    )
+    if (StackExhausted())
     {
-        ThrowError(expression->start, expression->end, Error {SyntaxError, "Invalid expression"});
+        ThrowError(expression->start, expression->end, Error {RecursionError, "Maximum nesting depth exceeded"});
+    }
+
+    switch (expression->kind)
+    {
+        case ParameterExpressionNode:
+        case QualifierExpressionNode:
+        case DeclareVariableNode:
+        case ClassDefinitionNode:
+        case IfStatementNode:
+        case SwitchStatementNode:
+        case ForLoopNode:
+        case ForEachLoopNode:
+        case WhileLoopNode:
+        case ReturnNode:
+        case BreakNode:
+        case ContinueNode:
+        case StatementEndNode:
+        {
+            ThrowError(expression->start, expression->end, Error {SyntaxError, "Invalid expression"});
+
+            break;
+        }
+        default:
+        {
+            break;
+        }
     }
 
     expression->CheckSemantics(call_stack);
 }
 
-bool InCallStack(vector<Node*> call_stack, string type)
+bool NeedsStatementEnd(Node *node)
+{
+    switch (node->kind)
+    {
+        case ClassDefinitionNode:
+        case IfStatementNode:
+        case SwitchStatementNode:
+        case ForLoopNode:
+        case ForEachLoopNode:
+        case WhileLoopNode:
+        case StatementEndNode:
+        {
+            return false;
+        }
+        default:
+        {
+            return true;
+        }
+    }
+}
+
+bool DeclaresNames(const vector<Node*> &statements)
+{
+    // If and switch blocks declare into the enclosing scope, nested loops get their own
+    for (Node *statement : statements)
+    {
+        switch (statement->kind)
+        {
+            case DeclareVariableNode:
+            case ClassDefinitionNode:
+            {
+                return true;
+            }
+            case IfStatementNode:
+            {
+                IfStatement *if_statement = (IfStatement*)statement;
+
+                if (DeclaresNames(if_statement->if_code_block->content) || (if_statement->else_code_block && DeclaresNames(if_statement->else_code_block->content)))
+                {
+                    return true;
+                }
+
+                for (CodeBlock *code_block : if_statement->else_if_code_blocks)
+                {
+                    if (DeclaresNames(code_block->content))
+                    {
+                        return true;
+                    }
+                }
+
+                break;
+            }
+            case SwitchStatementNode:
+            {
+                SwitchStatement *switch_statement = (SwitchStatement*)statement;
+
+                if (switch_statement->default_code_block && DeclaresNames(switch_statement->default_code_block->content))
+                {
+                    return true;
+                }
+
+                for (CodeBlock *code_block : switch_statement->case_code_blocks)
+                {
+                    if (DeclaresNames(code_block->content))
+                    {
+                        return true;
+                    }
+                }
+
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool InCallStack(const vector<Node*> &call_stack, NODE_KIND kind)
 {
     for (Node *node : call_stack)
     {
-        if (node->type == type)
+        if (node->kind == kind)
         {
             return true;
         }
@@ -130,13 +245,13 @@ bool InCallStack(vector<Node*> call_stack, string type)
     return false;
 }
 
-int CallStackPosition(vector<Node*> call_stack, string type)
+int CallStackPosition(const vector<Node*> &call_stack, NODE_KIND kind)
 {
     int position = -1;
 
     for (int i = 0; i < call_stack.size(); i++)
     {
-        if (call_stack[i]->type == type)
+        if (call_stack[i]->kind == kind)
         {
             position = i;
         }
@@ -12,8 +12,12 @@ void CheckStatement(Node *statement, std::vector<Node*> call_stack);
 
 void CheckExpression(Node *expression, std::vector<Node*> call_stack);
 
-bool InCallStack(std::vector<Node*> call_stack, std::string type);
+bool NeedsStatementEnd(Node *node);
 
-int CallStackPosition(std::vector<Node*> call_stack, std::string type);
+bool DeclaresNames(const std::vector<Node*> &statements);
+
+bool InCallStack(const std::vector<Node*> &call_stack, NODE_KIND kind);
+
+int CallStackPosition(const std::vector<Node*> &call_stack, NODE_KIND kind);
 
 #endif
\ No newline at end of file
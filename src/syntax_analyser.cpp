@@ -1,6 +1,7 @@
 #include <string>
 #include <vector>
-#include <regex>
+#include <string_view>
+#include <algorithm>
 
 #include "syntax_analyser.hpp"
 #include "token.hpp"
@@ -8,7 +9,27 @@
 
 using namespace std;
 
-pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<vector<pair<Token*, bool>>, bool> return_flags)
+// Binary operators, higher levels bind tighter
+constexpr pair<string_view, int> Operator_Precedence[] = {
+    { "^", 7 },
+    { "*", 6 }, { "/", 6 }, { "$", 6 }, { "%", 6 },
+    { "+", 5 }, { "-", 5 },
+    { "<", 4 }, { ">", 4 }, { "<=", 4 }, { ">=", 4 }, { "==", 4 }, { "!=", 4 },
+    { "&", 3 },
+    { "|", 2 },
+    { "=", 1 }, { "+=", 1 }, { "-=", 1 }, { "*=", 1 }, { "/=", 1 },
+};
+
+pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, NodeArena &arena, pair<vector<pair<Token*, bool>>, bool> return_flags)
+{
+    TokenCursor cursor = TokenCursor(tokens, arena);
+
+    vector<Node*> AST = ParseStatements(cursor, return_flags);
+
+    return {AST, vector<Token*>(tokens.begin() + cursor.position, tokens.end())};
+}
+
+vector<Node*> ParseStatements(TokenCursor &tokens, const pair<vector<pair<Token*, bool>>, bool> &return_flags)
 {
     vector<Node*> AST = vector<Node*>();
 
@@ -17,6 +38,11 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
     if (tokens.size() != 0)
     {
         file_end = tokens[tokens.size() - 1]->end;
+
+        if (StackExhausted())
+        {
+            ThrowError(tokens[0]->start, tokens[0]->end, Error {RecursionError, "Maximum nesting depth exceeded"});
+        }
     }
 
     while (tokens.size() != 0)
@@ -27,46 +53,46 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
         if (get<0>(return_flags).size() != 0 && ShouldReturn(tokens[0], get<0>(return_flags)) || (StatementStarted(AST) && get<1>(return_flags)))
         {
-            return {AST, tokens};
+            return AST;
         }
 
-        if (tokens[0]->type == "Integer" || tokens[0]->type == "Float" || tokens[0]->type == "String" || tokens[0]->type == "Boolean")
+        if (tokens[0]->kind == IntegerToken || tokens[0]->kind == FloatToken || tokens[0]->kind == StringToken || tokens[0]->kind == BooleanToken)
         {
-            Literal *l = new Literal();
+            Literal *l = tokens.arena->Create(Literal());
 
             l->start = start;
             l->end = tokens[0]->end;
 
-            string type = tokens[0]->type;
+            TOKEN_KIND kind = tokens[0]->kind;
 
             tuple<string, int, double, bool> vals = GetTokenValue(tokens[0]);
 
-            if (type == "Integer")
+            if (kind == IntegerToken)
             {
                 l->l_integer = get<1>(vals);
             }
-            else if (type == "Float")
+            else if (kind == FloatToken)
             {
                 l->l_float = get<2>(vals);
             }
-            else if (type == "String")
+            else if (kind == StringToken)
             {
                 l->l_string = get<0>(vals);
             }
-            else if (type == "Boolean")
+            else if (kind == BooleanToken)
             {
                 l->l_boolean = get<3>(vals);
             }
 
             AST.push_back(l);
 
-            EraseFront(&tokens, 1);
+            tokens.Advance(1);
         }
-        else if (tokens[0]->type == "Bracket" && get<0>(GetTokenValue(tokens[0])) == "(")
+        else if (tokens[0]->kind == BracketToken && get<0>(GetTokenValue(tokens[0])) == "(")
         {
             int start = tokens[0]->start;
 
-            if (EraseFront(&tokens, 1))
+            if (tokens.Advance(1))
             {
                 ThrowError(start, file_end, Error {SyntaxError, "Missing ending )"});
             }
@@ -75,16 +101,16 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
             bool got_arg = false;
 
-            while (!(tokens[0]->type == "Bracket" && get<0>(GetTokenValue(tokens[0])) == ")"))
+            while (!(tokens[0]->kind == BracketToken && get<0>(GetTokenValue(tokens[0])) == ")"))
             {
-                if (tokens[0]->type == "Control" && get<0>(GetTokenValue(tokens[0])) == ",")
+                if (tokens[0]->kind == ControlToken && get<0>(GetTokenValue(tokens[0])) == ",")
                 {
                     if (!got_arg)
                     {
                         ThrowError(start,tokens[0]->end, Error {SyntaxError, "Missing argument"});
                     }
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
                     }
@@ -96,70 +122,70 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 vector<Node*> data;
                 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (tokens.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
                 }
 
-                if (data.size() != 0 && (data[0]->type == "TypeExpression" || data[0]->type == "GetVariable"))
+                if (data.size() != 0 && (data[0]->kind == TypeExpressionNode || data[0]->kind == GetVariableNode))
                 {
                     got_arg = true;
 
                     TypeExpression param_type = TypeExpression("void", false, vector<TypeExpression>());
 
-                    if (data[0]->type == "TypeExpression")
+                    if (data[0]->kind == TypeExpressionNode)
                     {
                         param_type = *(TypeExpression*)data[0];
                     }
-                    else if (data[0]->type == "GetVariable")
+                    else if (data[0]->kind == GetVariableNode)
                     {
                         param_type = TypeExpression(((GetVariable*)data[0])->name, false, vector<TypeExpression>());
                     }
 
                     ARGUMENT_EXPANSION param_expansion = None;
 
-                    if (tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == "*")
+                    if (tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == "*")
                     {
                         param_expansion = Array;
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
                         }
 
-                        if (tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == "*")
+                        if (tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == "*")
                         {
                             param_expansion = Dictionary;
 
-                            if (EraseFront(&tokens, 1))
+                            if (tokens.Advance(1))
                             {
                                 ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
                             }
                         }
                     }
 
-                    if (tokens[0]->type == "Identifier")
+                    if (tokens[0]->kind == IdentifierToken)
                     {
                         string param_name = ((Identifier*)tokens[0])->name;
                         optional<Node*> param_def_value = optional<Node*>();
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
                         }
 
-                        if (tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == "=")
+                        if (tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == "=")
                         {
-                            if (EraseFront(&tokens, 1))
+                            if (tokens.Advance(1))
                             {
                                 ThrowError(start, file_end, Error {SyntaxError, "Missing end of default argument"});
                             }
 
                             vector<Node*> data;
 
-                            tie(data, tokens) = AnalyseSyntax(tokens, { { { new Control(","), false }, { new Bracket(")"), false } }, false });
+                            data = ParseStatements(tokens, { { { new Control(","), false }, { new Bracket(")"), false } }, false });
 
                             if (tokens.size() == 0)
                             {
@@ -189,22 +215,22 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
             int end;
 
-            if (EraseFront(&tokens, 1))
+            if (tokens.Advance(1))
             {
                 ThrowError(start, file_end, Error {SyntaxError, "Missing end of code block"});
             }
 
             TypeExpression return_type = TypeExpression("void", false, {});
 
-            if (tokens.size() > 1 && tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == "-" && tokens[1]->type == "Operator" && get<0>(GetTokenValue(tokens[1])) == ">") {
-                if (EraseFront(&tokens, 2))
+            if (tokens.size() > 1 && tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == "-" && tokens[1]->kind == OperatorToken && get<0>(GetTokenValue(tokens[1])) == ">") {
+                if (tokens.Advance(2))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing return type"});
                 }
 
                 vector<Node*> data;
                 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (tokens.size() == 0)
                 {
@@ -216,11 +242,11 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                     ThrowError(start, file_end, Error {SyntaxError, "Invalid character in code block"});
                 }
 
-                if (data[0]->type == "TypeExpression")
+                if (data[0]->kind == TypeExpressionNode)
                 {
                     return_type = *(TypeExpression*)data[0];
                 }
-                else if (data[0]->type == "GetVariable")
+                else if (data[0]->kind == GetVariableNode)
                 {
                     return_type = TypeExpression(((GetVariable*)data[0])->name, false, vector<TypeExpression>());
                 }
@@ -232,14 +258,14 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
             vector<Node*> content;
 
-            if (tokens[0]->type == "Bracket" && get<0>(GetTokenValue(tokens[0])) == "{")
+            if (tokens[0]->kind == BracketToken && get<0>(GetTokenValue(tokens[0])) == "{")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing ending }"});
                 }
 
-                tie(content, tokens) = AnalyseSyntax(tokens, { { { new Bracket("}"), false } }, false });
+                content = ParseStatements(tokens, { { { new Bracket("}"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
@@ -248,13 +274,13 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 end = tokens[0]->end;
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
             }
-            else if (tokens[0]->type == "Control" && get<0>(GetTokenValue(tokens[0])) == ";")
+            else if (tokens[0]->kind == ControlToken && get<0>(GetTokenValue(tokens[0])) == ";")
             {
                 end = tokens[0]->end;
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
 
                 content = vector<Node*>();
             }
@@ -263,116 +289,52 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                 ThrowError(start, tokens[0]->end, Error { SyntaxError, "Invalid character in code block" });
             }
 
-            Node *node = new CodeBlock(return_type, parameters, content);
+            Node *node = tokens.arena->Create(CodeBlock(return_type, parameters, content));
 
             node->start = start;
             node->end = end;
 
             AST.push_back(node);
         }
-        else if (tokens[0]->type == "Bracket" && get<0>(GetTokenValue(tokens[0])) == "{")
+        else if (tokens[0]->kind == BracketToken && get<0>(GetTokenValue(tokens[0])) == "{")
         {
             int start = tokens[0]->start;
 
-            if (EraseFront(&tokens, 1))
+            if (tokens.Advance(1))
             {
                 ThrowError(start, file_end, Error {SyntaxError, "Missing ending }"});
             }
 
             vector<Node*> content;
 
-            tie(content, tokens) = AnalyseSyntax(tokens, { { { new Bracket("}"), false } }, false });
+            content = ParseStatements(tokens, { { { new Bracket("}"), false } }, false });
 
             if (tokens.size() == 0)
             {
                 ThrowError(start, file_end, Error {SyntaxError, "Missing ending }"});
             }
 
-            CodeBlock *code_block = new CodeBlock(TypeExpression("void", false, {}), {}, content);
+            CodeBlock *code_block = tokens.arena->Create(CodeBlock(TypeExpression("void", false, {}), {}, content));
 
             code_block->start = start;
             code_block->end = tokens[0]->end;
 
             AST.push_back(code_block);
 
-            EraseFront(&tokens, 1);
+            tokens.Advance(1);
         }
-        else if (StatementStarted(AST) && tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == "^")
-        {
-            Node *left = GetASTEnd(AST);
-
-            AST.pop_back();
-
-            if (EraseFront(&tokens, 1))
-            {
-                ThrowError(start, file_end, Error {SyntaxError, "Missing right expression for operation"});
-            }
-
-            vector<Node*> content;
-
-            tie(content, tokens) = AnalyseSyntax(tokens, { {}, true });
-
-            if (tokens.size() == 0 && StatementStarted(content))
-            {
-                ThrowError(start, file_end, Error {SyntaxError, "Missing ending ;"});
-            }
-            else if (tokens.size() == 0)
-            {
-                ThrowError(start, file_end, Error {SyntaxError, "Missing right expression for operation"});
-            }
-
-            if (content.size() == 0)
-            {
-                ThrowError(start, tokens[0]->end, Error {SyntaxError, "Missing right expression for operation"});
-            }
-            else if (content[0]->type == "StatementEnd")
-            {
-                ThrowError(start, tokens[0]->end, Error {SyntaxError, "Missing right expression for operation"});
-            }
-
-            Node *right = content[0];
-
-            Operation *operation;
-
-            if (left->type == "Operation" && ((Operation*)left)->left == NULL)
-            {
-                Operation *unary = (Operation*)left;
-
-                Operation *binary = new Operation("^", unary->right, right);
-
-                binary->start = start;
-
-                binary->end = tokens[0]->end;
-
-                operation = new Operation(unary->operator_string, NULL, binary);
-
-                operation->start = unary->start;
-
-                operation->end = tokens[0]->end;
-            }
-            else
-            {
-                operation = new Operation("^", left, right);
-
-                operation->start = start;
-
-                operation->end = tokens[0]->end;
-            }
-
-            AST.push_back(operation);
-        }
-        else if (!StatementStarted(AST) && tokens[0]->type == "Operator" && (get<0>(GetTokenValue(tokens[0])) == "!" || get<0>(GetTokenValue(tokens[0])) == "+" || get<0>(GetTokenValue(tokens[0])) == "-"))
+        else if (!StatementStarted(AST) && tokens[0]->kind == OperatorToken && (get<0>(GetTokenValue(tokens[0])) == "!" || get<0>(GetTokenValue(tokens[0])) == "+" || get<0>(GetTokenValue(tokens[0])) == "-"))
         {
             string operator_string = get<0>(GetTokenValue(tokens[0]));
 
-            if (EraseFront(&tokens, 1))
+            if (tokens.Advance(1))
             {
                 ThrowError(start, file_end, Error {SyntaxError, "Missing right expression for operation"});
             }
 
             vector<Node*> content;
 
-            tie(content, tokens) = AnalyseSyntax(tokens, { {}, true });
+            content = ParseStatements(tokens, { {}, true });
 
             if (tokens.size() == 0 && StatementStarted(content))
             {
@@ -387,43 +349,40 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             {
                 ThrowError(start, tokens[0]->end, Error {SyntaxError, "Missing right expression for operation"});
             }
-            else if (content[0]->type == "StatementEnd")
+            else if (content[0]->kind == StatementEndNode)
             {
                 ThrowError(start, tokens[0]->end, Error {SyntaxError, "Missing right expression for operation"});
             }
 
-            Node *right = content[0];
+            // Only ^ binds tighter than a unary operator, so -a ^ b is -(a ^ b)
+            Node *right = ParseOperation(tokens, start, file_end, content[0], GetOperatorPrecedence("^"));
 
-            Operation *operation = new Operation(operator_string, NULL, right);
+            Operation *operation = tokens.arena->Create(Operation(operator_string, NULL, right));
 
             operation->start = start;
 
-            operation->end = tokens[0]->end;
+            operation->end = right->end;
 
             AST.push_back(operation);
         }
-        else if (StatementStarted(AST) && tokens[0]->type == "Operator")
+        else if (StatementStarted(AST) && tokens[0]->kind == OperatorToken)
         {
             OPERATION:
                 Node *left = GetASTEnd(AST);
 
                 AST.pop_back();
 
-                Operation *operation;
-                
-                tie(operation, tokens) = ProcessOperations(return_flags, start, tokens, left);
-
-                AST.push_back(operation);
+                AST.push_back(ParseOperation(tokens, start, file_end, left, 1));
         }
-        else if (tokens[0]->type == "Identifier")
+        else if (tokens[0]->kind == IdentifierToken)
         {
-            if (!last && tokens[1]->type == "Operator" && get<0>(GetTokenValue(tokens[1])) == "<")
+            if (!last && tokens[1]->kind == OperatorToken && get<0>(GetTokenValue(tokens[1])) == "<")
             {
-                vector<Token*> old_tokens(tokens);
+                int old_position = tokens.position;
 
                 string name = ((Identifier*)tokens[0])->name;
 
-                if (EraseFront(&tokens, 2))
+                if (tokens.Advance(2))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of type"});
                 }
@@ -434,17 +393,17 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 bool got_arg = false;
 
-                while (!(tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == ">"))
+                while (!(tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == ">"))
                 {
                     vector<Node*> data;
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { GetReturnTokens({ new Control(","), new Operator(">") }, get<0>(return_flags)), false });
+                    data = ParseStatements(tokens, { GetReturnTokens({ new Control(","), new Operator(">") }, get<0>(return_flags)), false });
 
                     if (tokens.size() == 0 || (tokens.size() != 0 && get<0>(GetTokenValue(tokens[0])) != "," && get<0>(GetTokenValue(tokens[0])) != ">"))
                     {
-                        tokens = old_tokens;
+                        tokens.position = old_position;
 
-                        Node *node = new GetVariable(name);
+                        Node *node = tokens.arena->Create(GetVariable(name));
 
                         node->start = start;
 
@@ -452,7 +411,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                         AST.push_back(node);
 
-                        EraseFront(&tokens, 1);
+                        tokens.Advance(1);
 
                         goto OPERATION;
                     }
@@ -464,13 +423,13 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         break;
                     }
 
-                    if (data[0]->type == "TypeExpression")
+                    if (data[0]->kind == TypeExpressionNode)
                     {
                         content.push_back(*(TypeExpression*)data[0]);
 
                         got_arg = true;
                     }
-                    else if (data[0]->type == "GetVariable")
+                    else if (data[0]->kind == GetVariableNode)
                     {
                         content.push_back(TypeExpression(((GetVariable*)data[0])->name, false, vector<TypeExpression>()));
 
@@ -488,14 +447,14 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         ThrowError(start, file_end, Error {SyntaxError, "Missing ending >"});
                     }
 
-                    if (tokens[0]->type == "Control" && get<0>(GetTokenValue(tokens[0])) == ",")
+                    if (tokens[0]->kind == ControlToken && get<0>(GetTokenValue(tokens[0])) == ",")
                     {
                         if (!got_arg)
                         {
                             ThrowError(start,tokens[0]->end, Error {SyntaxError, "Missing type argument"});
                         }
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of type"});
                         }
@@ -504,7 +463,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                         continue;
                     }
-                    else if (tokens[0]->type == "Operator" && get<0>(GetTokenValue(tokens[0])) == ">")
+                    else if (tokens[0]->kind == OperatorToken && get<0>(GetTokenValue(tokens[0])) == ">")
                     {
                         continue;
                     }
@@ -518,11 +477,11 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 if (!is_type)
                 {
-                    tokens = old_tokens;
+                    tokens.position = old_position;
                 }
                 else
                 {
-                    TypeExpression *type = new TypeExpression(name, false, content);
+                    TypeExpression *type = tokens.arena->Create(TypeExpression(name, false, content));
 
                     type->start = start;
 
@@ -530,14 +489,14 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     AST.push_back(type);
 
-                    EraseFront(&tokens, 1);
+                    tokens.Advance(1);
                 }
             }
-            else if (!last && tokens.size() > 2 && tokens[1]->type == "Bracket" && get<0>(GetTokenValue(tokens[1])) == "[" && tokens[2]->type == "Bracket" && get<0>(GetTokenValue(tokens[2])) == "]")
+            else if (!last && tokens.size() > 2 && tokens[1]->kind == BracketToken && get<0>(GetTokenValue(tokens[1])) == "[" && tokens[2]->kind == BracketToken && get<0>(GetTokenValue(tokens[2])) == "]")
             {
                 string name = ((Identifier*)tokens[0])->name;
 
-                TypeExpression *type = new TypeExpression(name, true, {});
+                TypeExpression *type = tokens.arena->Create(TypeExpression(name, true, {}));
 
                 type->start = start;
 
@@ -545,9 +504,9 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 AST.push_back(type);
 
-                EraseFront(&tokens, 3);
+                tokens.Advance(3);
             }
-            else if (!last && StatementStarted(AST) && (GetASTEnd(AST)->type == "TypeExpression" || GetASTEnd(AST)->type == "GetVariable") && tokens[1]->type == "Bracket" && get<0>(GetTokenValue(tokens[1])) == "(")
+            else if (!last && StatementStarted(AST) && (GetASTEnd(AST)->kind == TypeExpressionNode || GetASTEnd(AST)->kind == GetVariableNode) && tokens[1]->kind == BracketToken && get<0>(GetTokenValue(tokens[1])) == "(")
             {
                 TypeExpression *return_type = NULL;
 
@@ -555,18 +514,18 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 AST.pop_back();
 
-                if (n->type == "TypeExpression")
+                if (n->kind == TypeExpressionNode)
                 {
                     return_type = (TypeExpression*)n;
                 }
-                else if (n->type == "GetVariable")
+                else if (n->kind == GetVariableNode)
                 {
-                    return_type = new TypeExpression(((GetVariable*)n)->name, false, vector<TypeExpression>());
+                    return_type = tokens.arena->Create(TypeExpression(((GetVariable*)n)->name, false, vector<TypeExpression>()));
                 }
 
-                QualifierExpression *qualifier = new QualifierExpression({});
+                QualifierExpression *qualifier = tokens.arena->Create(QualifierExpression({}));
 
-                if (StatementStarted(AST) && GetASTEnd(AST)->type == "QualifierExpression")
+                if (StatementStarted(AST) && GetASTEnd(AST)->kind == QualifierExpressionNode)
                 {
                     qualifier = (QualifierExpression*)GetASTEnd(AST);
 
@@ -575,18 +534,18 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 string name = get<0>(GetTokenValue(tokens[0]));
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (data.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (data[0]->type != "CodeBlock")
+                if (data[0]->kind != CodeBlockNode)
                 {
                     ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in function definition"});
                 }
@@ -608,21 +567,21 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                 func_type.start = start;
                 func_type.end = code_block->end;
 
-                Node *node = new DeclareVariable(qualifier, func_type, name, code_block);
+                Node *node = tokens.arena->Create(DeclareVariable(qualifier, func_type, name, code_block));
 
                 node->start = start;
                 node->end = code_block->end;
 
                 AST.push_back(node);
 
-                StatementEnd *statement_end = new StatementEnd();
+                StatementEnd *statement_end = tokens.arena->Create(StatementEnd());
 
                 statement_end->end = code_block->end - 1;
                 statement_end->start = code_block->end;
 
                 AST.push_back(statement_end);
             }
-            else if (!last && StatementStarted(AST) && (GetASTEnd(AST)->type == "TypeExpression" || GetASTEnd(AST)->type == "GetVariable") && tokens[1]->type == "Operator" && get<0>(GetTokenValue(tokens[1])) == "=")
+            else if (!last && StatementStarted(AST) && (GetASTEnd(AST)->kind == TypeExpressionNode || GetASTEnd(AST)->kind == GetVariableNode) && tokens[1]->kind == OperatorToken && get<0>(GetTokenValue(tokens[1])) == "=")
             {
                 TypeExpression variable_type = TypeExpression("void", false, vector<TypeExpression>());
 
@@ -630,18 +589,18 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 AST.pop_back();
 
-                if (n->type == "TypeExpression")
+                if (n->kind == TypeExpressionNode)
                 {
                     variable_type = *(TypeExpression*)n;
                 }
-                else if (n->type == "GetVariable")
+                else if (n->kind == GetVariableNode)
                 {
                     variable_type = TypeExpression(((GetVariable*)n)->name, false, vector<TypeExpression>());
                 }
 
-                QualifierExpression *qualifier = new QualifierExpression({});
+                QualifierExpression *qualifier = tokens.arena->Create(QualifierExpression({}));
 
-                if (StatementStarted(AST) && GetASTEnd(AST)->type == "QualifierExpression")
+                if (StatementStarted(AST) && GetASTEnd(AST)->kind == QualifierExpressionNode)
                 {
                     qualifier = (QualifierExpression*)GetASTEnd(AST);
 
@@ -650,14 +609,14 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 string name = get<0>(GetTokenValue(tokens[0]));
 
-                if (EraseFront(&tokens, 2))
+                if (tokens.Advance(2))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of declaration"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
+                data = ParseStatements(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
 
                 if (tokens.size() == 0)
                 {
@@ -671,18 +630,18 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 Node *content = data[0];
 
-                Node *node = new DeclareVariable(qualifier, variable_type, name, content);
+                Node *node = tokens.arena->Create(DeclareVariable(qualifier, variable_type, name, content));
 
                 node->start = start;
                 node->end = tokens[0]->end;
 
                 AST.push_back(node);
             }
-            else if (!last && tokens[1]->type == "Bracket" && get<0>(GetTokenValue(tokens[1])) == "(")
+            else if (!last && tokens[1]->kind == BracketToken && get<0>(GetTokenValue(tokens[1])) == "(")
             {
                 string name = ((Identifier*)tokens[0])->name;
 
-                if (EraseFront(&tokens, 2))
+                if (tokens.Advance(2))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of function call"});
                 }
@@ -691,16 +650,16 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 bool got_arg = false;
 
-                while (!(tokens[0]->type == "Bracket" && get<0>(GetTokenValue(tokens[0])) == ")"))
+                while (!(tokens[0]->kind == BracketToken && get<0>(GetTokenValue(tokens[0])) == ")"))
                 {
-                    if (tokens[0]->type == "Control" && get<0>(GetTokenValue(tokens[0])) == ",")
+                    if (tokens[0]->kind == ControlToken && get<0>(GetTokenValue(tokens[0])) == ",")
                     {
                         if (!got_arg)
                         {
                             ThrowError(start,tokens[0]->end, Error {SyntaxError, "Missing argument"});
                         }
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of function call"});
                         }
@@ -712,7 +671,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     vector<Node*> data;
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { { { new Control(","), false }, { new Bracket(")"), false } }, false });
+                    data = ParseStatements(tokens, { { { new Control(","), false }, { new Bracket(")"), false } }, false });
 
                     if (tokens.size() == 0)
                     {
@@ -729,27 +688,27 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                     arguments.push_back(data[0]);
                 }
 
-                FunctionCall *function_call = new FunctionCall(name, arguments);
+                FunctionCall *function_call = tokens.arena->Create(FunctionCall(name, arguments));
 
                 function_call->start = start;
                 function_call->end = tokens[0]->end;
 
                 AST.push_back(function_call);
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
             }
-            else if (!last && tokens[1]->type == "Control" && get<0>(GetTokenValue(tokens[1])) == ".")
+            else if (!last && tokens[1]->kind == ControlToken && get<0>(GetTokenValue(tokens[1])) == ".")
             {
                 string name = ((Identifier*)tokens[0])->name;
 
-                if (EraseFront(&tokens, 2))
+                if (tokens.Advance(2))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
+                data = ParseStatements(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
 
                 if (tokens.size() == 0)
                 {
@@ -766,12 +725,12 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                     ThrowError(start, tokens[0]->end, Error {SyntaxError, "Too many expressions"});
                 }
 
-                if (data[0]->type != "GetVariable" && data[0]->type != "FunctionCall" && data[0]->type != "MemberAccess")
+                if (data[0]->kind != GetVariableNode && data[0]->kind != FunctionCallNode && data[0]->kind != MemberAccessNode)
                 {
                     ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid expression in member access"});
                 }
 
-                MemberAccess *member_access = new MemberAccess(name, data[0]);
+                MemberAccess *member_access = tokens.arena->Create(MemberAccess(name, data[0]));
 
                 member_access->start = start;
                 member_access->end = tokens[0]->end;
@@ -782,11 +741,11 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             {
                 Node *node;
 
-                if (!StatementStarted(AST) || GetASTEnd(AST)->type == "QualifierExpression")
+                if (!StatementStarted(AST) || GetASTEnd(AST)->kind == QualifierExpressionNode)
                 {
-                    node = new GetVariable(((Identifier*)tokens[0])->name);
+                    node = tokens.arena->Create(GetVariable(((Identifier*)tokens[0])->name));
                 }
-                else if (GetASTEnd(AST)->type == "TypeExpression" || GetASTEnd(AST)->type == "GetVariable")
+                else if (GetASTEnd(AST)->kind == TypeExpressionNode || GetASTEnd(AST)->kind == GetVariableNode)
                 {
                     TypeExpression variable_type = TypeExpression("void", false, vector<TypeExpression>());
 
@@ -794,25 +753,25 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     AST.pop_back();
 
-                    if (n->type == "TypeExpression")
+                    if (n->kind == TypeExpressionNode)
                     {
                         variable_type = *(TypeExpression*)n;
                     }
-                    else if (n->type == "GetVariable")
+                    else if (n->kind == GetVariableNode)
                     {
                         variable_type = TypeExpression(((GetVariable*)n)->name, false, vector<TypeExpression>());
                     }
 
-                    QualifierExpression *qualifier = new QualifierExpression({});
+                    QualifierExpression *qualifier = tokens.arena->Create(QualifierExpression({}));
 
-                    if (StatementStarted(AST) && GetASTEnd(AST)->type == "QualifierExpression")
+                    if (StatementStarted(AST) && GetASTEnd(AST)->kind == QualifierExpressionNode)
                     {
                         qualifier = (QualifierExpression*)GetASTEnd(AST);
 
                         AST.pop_back();
                     }
 
-                    node = new DeclareVariable(qualifier, variable_type, ((Identifier*)tokens[0])->name, NULL);
+                    node = tokens.arena->Create(DeclareVariable(qualifier, variable_type, ((Identifier*)tokens[0])->name, NULL));
                 }
                 else
                 {
@@ -824,10 +783,10 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 AST.push_back(node);
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
             }
         }
-        else if (tokens[0]->type == "Keyword")
+        else if (tokens[0]->kind == KeywordToken)
         {
             if (get<0>(GetTokenValue(tokens[0])) == "public" || get<0>(GetTokenValue(tokens[0])) == "static" || get<0>(GetTokenValue(tokens[0])) == "const")
             {
@@ -841,7 +800,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     end = tokens[0]->end;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing ending of statement"});
                     }
@@ -853,7 +812,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     end = tokens[0]->end;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing ending of statement"});
                     }
@@ -865,13 +824,13 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     end = tokens[0]->end;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing ending of statement"});
                     }
                 }
 
-                Node *node = new QualifierExpression(qualifiers);
+                Node *node = tokens.arena->Create(QualifierExpression(qualifiers));
 
                 node->start = start;
                 node->end = end;
@@ -880,58 +839,58 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "class")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Identifier")
+                if (tokens[0]->kind != IdentifierToken)
                 {
                     ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid character in class definition"});
                 }
 
                 string name = ((Identifier*)tokens[0])->name;
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 string interface = "";
 
-                if (tokens[0]->type == "Control" && ((Control*)tokens[0])->value == ":")
+                if (tokens[0]->kind == ControlToken && ((Control*)tokens[0])->value == ":")
                 {
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (tokens[0]->type != "Identifier")
+                    if (tokens[0]->kind != IdentifierToken)
                     {
                         ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid character in class definition"});
                     }
 
                     interface = ((Identifier*)tokens[0])->name;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "{")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "{")
                 {
                     ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid character in class definition"});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket("}"), false } }, false });
+                data = ParseStatements(tokens, { { { new Bracket("}"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
@@ -940,45 +899,45 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 for (Node *node : data)
                 {
-                    if (node->type != "DeclareVariable" && node->type != "StatementEnd")
+                    if (node->kind != DeclareVariableNode && node->kind != StatementEndNode)
                     {
                         ThrowError(node->start, node->end, Error {SyntaxError, "Expected declaration"});
                     }
                 }
 
-                ClassDefinition *class_definition = new ClassDefinition(name, interface, data);
+                ClassDefinition *class_definition = tokens.arena->Create(ClassDefinition(name, interface, data));
 
                 class_definition->start = start;
                 class_definition->end = tokens[0]->end;
 
                 AST.push_back(class_definition);
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "new")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (data.size() == 0)
                 {
                     ThrowError(tokens[0]->start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (data[0]->type != "FunctionCall")
+                if (data[0]->kind != FunctionCallNode)
                 {
                     ThrowError(tokens[0]->start, data[0]->end, Error {SyntaxError, "Invalid character in class instance"});
                 }
 
                 FunctionCall *function_call = (FunctionCall*)data[0];
 
-                InstanceClass *instance_class = new InstanceClass(function_call->name, function_call->arguments);
+                InstanceClass *instance_class = tokens.arena->Create(InstanceClass(function_call->name, function_call->arguments));
 
                 instance_class->start = start;
                 instance_class->end = function_call->end;
@@ -987,24 +946,24 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "if")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing starting ("});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
@@ -1018,26 +977,26 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 Node *if_expression = data[0];
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (data.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (data[0]->type != "CodeBlock")
+                if (data[0]->kind != CodeBlockNode)
                 {
                     ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in if statement"});
                 }
 
                 CodeBlock *if_code_block = (CodeBlock*)data[0];
 
-                IfStatement *if_statement = new IfStatement(if_expression, if_code_block, {}, {}, NULL);
+                IfStatement *if_statement = tokens.arena->Create(IfStatement(if_expression, if_code_block, {}, {}, NULL));
 
                 int end = if_code_block->end;
 
@@ -1046,29 +1005,29 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     while (true)
                     {
-                        if (tokens.size() < 2 || tokens[0]->type != "Keyword" || ((Keyword*)tokens[0])->name != "else" || tokens[1]->type != "Keyword" || ((Keyword*)tokens[1])->name != "if")
+                        if (tokens.size() < 2 || tokens[0]->kind != KeywordToken || ((Keyword*)tokens[0])->name != "else" || tokens[1]->kind != KeywordToken || ((Keyword*)tokens[1])->name != "if")
                         {
                             break;
                         }
 
                         int else_if_start = tokens[0]->start;
 
-                        if (EraseFront(&tokens, 2))
+                        if (tokens.Advance(2))
                         {
                             ThrowError(else_if_start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                        if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                         {
                             ThrowError(else_if_start, file_end, Error {SyntaxError, "Missing starting ("});
                         }
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(else_if_start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                        data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                         if (tokens.size() == 0)
                         {
@@ -1082,19 +1041,19 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                         Node *else_if_expression = data[0];
 
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(else_if_start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                        data = ParseStatements(tokens, { {}, true });
 
                         if (data.size() == 0)
                         {
                             ThrowError(else_if_start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        if (data[0]->type != "CodeBlock")
+                        if (data[0]->kind != CodeBlockNode)
                         {
                             ThrowError(else_if_start, data[0]->end, Error {SyntaxError, "Invalid character in if statement"});
                         }
@@ -1107,7 +1066,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         end = else_if_code_block->end;
                     }
 
-                    if (tokens[0]->type != "Keyword" || ((Keyword*)tokens[0])->name != "else")
+                    if (tokens[0]->kind != KeywordToken || ((Keyword*)tokens[0])->name != "else")
                     {
                         if_statement->start = start;
                         if_statement->end = end;
@@ -1119,19 +1078,19 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     int else_start = tokens[0]->start;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(else_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                    data = ParseStatements(tokens, { {}, true });
 
                     if (data.size() == 0)
                     {
                         ThrowError(else_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (data[0]->type != "CodeBlock")
+                    if (data[0]->kind != CodeBlockNode)
                     {
                         ThrowError(else_start, data[0]->end, Error {SyntaxError, "Invalid character in if statement"});
                     }
@@ -1150,24 +1109,24 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "switch")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing starting ("});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
@@ -1181,33 +1140,33 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 Node *switch_expression = data[0];
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "{")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "{")
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing starting {"});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                SwitchStatement *switch_statement = new SwitchStatement(switch_expression, {}, {}, NULL);
+                SwitchStatement *switch_statement = tokens.arena->Create(SwitchStatement(switch_expression, {}, {}, NULL));
 
-                while (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "}")
+                while (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "}")
                 {
-                    if (tokens[0]->type == "Keyword" && ((Keyword*)tokens[0])->name == "default")
+                    if (tokens[0]->kind == KeywordToken && ((Keyword*)tokens[0])->name == "default")
                     {
-                        if (EraseFront(&tokens, 1))
+                        if (tokens.Advance(1))
                         {
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                        data = ParseStatements(tokens, { {}, true });
 
                         if (tokens.size() == 0)
                         {
@@ -1219,7 +1178,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                             ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                         }
 
-                        if (data[0]->type != "CodeBlock")
+                        if (data[0]->kind != CodeBlockNode)
                         {
                             ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in switch statement"});
                         }
@@ -1228,7 +1187,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                         switch_statement->default_code_block = default_code_block;
 
-                        if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "}")
+                        if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "}")
                         {
                             ThrowError(start, tokens[0]->end, Error {SyntaxError, "Missing ending }"});
                         }
@@ -1236,31 +1195,31 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         break;
                     }
 
-                    if (tokens[0]->type != "Keyword" || ((Keyword*)tokens[0])->name != "case")
+                    if (tokens[0]->kind != KeywordToken || ((Keyword*)tokens[0])->name != "case")
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Invalid character in switch statement"});
                     }
 
                     int case_start = tokens[0]->start;
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(case_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                    if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                     {
                         ThrowError(case_start, file_end, Error {SyntaxError, "Missing starting ("});
                     }
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(case_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
                     vector<Node*> data;
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                    data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                     if (tokens.size() == 0)
                     {
@@ -1274,12 +1233,12 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     Node *case_expression = data[0];
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(case_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                    data = ParseStatements(tokens, { {}, true });
 
                     if (tokens.size() == 0)
                     {
@@ -1291,7 +1250,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         ThrowError(case_start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (data[0]->type != "CodeBlock")
+                    if (data[0]->kind != CodeBlockNode)
                     {
                         ThrowError(case_start, data[0]->end, Error {SyntaxError, "Invalid character in switch statement"});
                     }
@@ -1307,51 +1266,51 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 AST.push_back(switch_statement);
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "for")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing starting ("});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false }, { new Control(":"), false } }, false });
+                data = ParseStatements(tokens, { { { new Bracket(")"), false }, { new Control(":"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing ending )"});
                 }
 
-                if (tokens[0]->type == "Control" && ((Control*)tokens[0])->value == ":")
+                if (tokens[0]->kind == ControlToken && ((Control*)tokens[0])->value == ":")
                 {
-                    if (data.size() != 1 || data[0]->type != "DeclareVariable" || ((DeclareVariable*)data[0])->value != NULL)
+                    if (data.size() != 1 || data[0]->kind != DeclareVariableNode || ((DeclareVariable*)data[0])->value != NULL)
                     {
                         ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid expression in for loop"});
                     }
 
                     DeclareVariable *declaration = (DeclareVariable*)data[0];
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
                     vector<Node*> data;
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                    data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                     if (tokens.size() == 0)
                     {
@@ -1365,26 +1324,26 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     Node *iteration_expression = data[0];
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                    data = ParseStatements(tokens, { {}, true });
 
                     if (data.size() == 0)
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (data[0]->type != "CodeBlock")
+                    if (data[0]->kind != CodeBlockNode)
                     {
                         ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in for loop"});
                     }
 
                     CodeBlock *for_code_block = (CodeBlock*)data[0];
 
-                    ForEachLoop *for_each_loop = new ForEachLoop(declaration, iteration_expression, for_code_block);
+                    ForEachLoop *for_each_loop = tokens.arena->Create(ForEachLoop(declaration, iteration_expression, for_code_block));
 
                     for_each_loop->start = start;
                     for_each_loop->end = for_code_block->end;
@@ -1399,7 +1358,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                     for (int i = 0; i < data.size(); i++)
                     {
-                        if (data[i]->type != "StatementEnd")
+                        if (data[i]->kind != StatementEndNode)
                         {
                             if (current_expression != NULL)
                             {
@@ -1416,7 +1375,7 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         }
                     }
 
-                    if (current_expression != NULL || (data[data.size() - 1]->type == "StatementEnd" && expressions.size() == 2))
+                    if (current_expression != NULL || (data[data.size() - 1]->kind == StatementEndNode && expressions.size() == 2))
                     {
                         expressions.push_back(current_expression);
                     }
@@ -1431,26 +1390,26 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
                         ThrowError(tokens[0]->start, tokens[0]->end, Error {SyntaxError, "Too many expressions"});
                     }
 
-                    if (EraseFront(&tokens, 1))
+                    if (tokens.Advance(1))
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                    data = ParseStatements(tokens, { {}, true });
 
                     if (data.size() == 0)
                     {
                         ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                     }
 
-                    if (data[0]->type != "CodeBlock")
+                    if (data[0]->kind != CodeBlockNode)
                     {
                         ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in for loop"});
                     }
 
                     CodeBlock *for_code_block = (CodeBlock*)data[0];
 
-                    ForLoop *for_loop = new ForLoop(expressions[0], expressions[1], expressions[2], for_code_block);
+                    ForLoop *for_loop = tokens.arena->Create(ForLoop(expressions[0], expressions[1], expressions[2], for_code_block));
 
                     for_loop->start = start;
                     for_loop->end = for_code_block->end;
@@ -1460,24 +1419,24 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             }
             else if (get<0>(GetTokenValue(tokens[0])) == "while")
             {
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (tokens[0]->type != "Bracket" || ((Bracket*)tokens[0])->value != "(")
+                if (tokens[0]->kind != BracketToken || ((Bracket*)tokens[0])->value != "(")
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing starting ("});
                 }
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { { { new Bracket(")"), false } }, false });
+                data = ParseStatements(tokens, { { { new Bracket(")"), false } }, false });
 
                 if (tokens.size() == 0)
                 {
@@ -1491,26 +1450,26 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
 
                 Node *while_condition = data[0];
 
-                if (EraseFront(&tokens, 1))
+                if (tokens.Advance(1))
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+                data = ParseStatements(tokens, { {}, true });
 
                 if (data.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing end of statement"});
                 }
 
-                if (data[0]->type != "CodeBlock")
+                if (data[0]->kind != CodeBlockNode)
                 {
                     ThrowError(start, data[0]->end, Error {SyntaxError, "Invalid character in if statement"});
                 }
 
                 CodeBlock *while_code_block = (CodeBlock*)data[0];
 
-                WhileLoop *while_loop = new WhileLoop(while_condition, while_code_block);
+                WhileLoop *while_loop = tokens.arena->Create(WhileLoop(while_condition, while_code_block));
 
                 while_loop->start = start;
                 while_loop->end = while_code_block->end;
@@ -1521,18 +1480,18 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             {
                 int end = tokens[0]->end;
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
 
                 vector<Node*> data;
 
-                tie(data, tokens) = AnalyseSyntax(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
+                data = ParseStatements(tokens, { GetReturnTokens({ new Control(";") }, get<0>(return_flags)), false });
 
                 if (tokens.size() == 0)
                 {
                     ThrowError(start, file_end, Error {SyntaxError, "Missing ending ;"});
                 }
 
-                Return *return_statement = new Return(NULL);
+                Return *return_statement = tokens.arena->Create(Return(NULL));
 
                 if (data.size() != 0)
                 {
@@ -1548,9 +1507,9 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             {
                 int end = tokens[0]->end;
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
 
-                Break *break_statement = new Break();
+                Break *break_statement = tokens.arena->Create(Break());
 
                 break_statement->start = start;
                 break_statement->end = end;
@@ -1561,21 +1520,25 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
             {
                 int end = tokens[0]->end;
 
-                EraseFront(&tokens, 1);
+                tokens.Advance(1);
 
-                Continue *continue_statement = new Continue();
+                Continue *continue_statement = tokens.arena->Create(Continue());
 
                 continue_statement->start = start;
                 continue_statement->end = end;
 
                 AST.push_back(continue_statement);
             }
+            else
+            {
+                ThrowError(tokens[0]->start, tokens[0]->end, Error {SyntaxError, "Invalid statement start"});
+            }
         }
-        else if (tokens[0]->type == "Control" && get<0>(GetTokenValue(tokens[0])) == ";")
+        else if (tokens[0]->kind == ControlToken && get<0>(GetTokenValue(tokens[0])) == ";")
         {
-            EraseFront(&tokens, 1);
+            tokens.Advance(1);
 
-            Node *node = new StatementEnd();
+            Node *node = tokens.arena->Create(StatementEnd());
 
             node->start = start;
             node->end = start + 1;
@@ -1588,10 +1551,10 @@ pair<vector<Node*>, vector<Token*>> AnalyseSyntax(vector<Token*> tokens, pair<ve
         }
     }
 
-    return {AST, tokens};
+    return AST;
 }
 
-Node* GetASTEnd(vector<Node*> AST)
+Node* GetASTEnd(const vector<Node*> &AST)
 {
     if (AST.size() != 0)
     {
@@ -1603,7 +1566,7 @@ Node* GetASTEnd(vector<Node*> AST)
     }
 }
 
-bool ShouldReturn(Token *current_token, vector<pair<Token*, bool>> return_tokens)
+bool ShouldReturn(Token *current_token, const vector<pair<Token*, bool>> &return_tokens)
 {
     for (pair<Token*, bool> ret_t : return_tokens)
     {
@@ -1616,21 +1579,35 @@ bool ShouldReturn(Token *current_token, vector<pair<Token*, bool>> return_tokens
     return false;
 }
 
-bool StatementStarted(std::vector<Node*> AST)
+bool StatementStarted(const vector<Node*> &AST)
 {
     Node *n = GetASTEnd(AST);
 
-    if (GetASTEnd(AST) == NULL || GetASTEnd(AST)->type == "StatementEnd" || GetASTEnd(AST)->type == "ClassDefinition" ||
-        GetASTEnd(AST)->type == "IfStatement" || GetASTEnd(AST)->type == "SwitchStatememnt" || GetASTEnd(AST)->type == "ForLoop" ||
-        GetASTEnd(AST)->type == "ForEachLoop" || GetASTEnd(AST)->type == "WhileLoop")
+    if (n == NULL)
     {
         return false;
     }
 
-    return true;
+    switch (n->kind)
+    {
+        case StatementEndNode:
+        case ClassDefinitionNode:
+        case IfStatementNode:
+        case SwitchStatementNode:
+        case ForLoopNode:
+        case ForEachLoopNode:
+        case WhileLoopNode:
+        {
+            return false;
+        }
+        default:
+        {
+            return true;
+        }
+    }
 }
 
-vector<pair<Token*, bool>> GetReturnTokens(vector<Token*> new_return_tokens, vector<pair<Token*, bool>> existing_return_tokens)
+vector<pair<Token*, bool>> GetReturnTokens(vector<Token*> new_return_tokens, const vector<pair<Token*, bool>> &existing_return_tokens)
 {
     vector<pair<Token*, bool>> return_tokens = {};
 
@@ -1651,34 +1628,47 @@ vector<pair<Token*, bool>> GetReturnTokens(vector<Token*> new_return_tokens, vec
     return return_tokens;
 }
 
-pair<Operation*, vector<Token*>> ProcessOperations(pair<vector<pair<Token*, bool>>, bool> return_flags, int start, vector<Token*> tokens, Node *left)
+int GetOperatorPrecedence(string operator_string)
 {
-    int file_end = tokens[tokens.size()-1]->end;
-
-    vector<Node*> values = { left };
+    for (pair<string_view, int> precedence : Operator_Precedence)
+    {
+        if (precedence.first == operator_string)
+        {
+            return precedence.second;
+        }
+    }
 
-    vector<string> operators = { };
+    return 0;
+}
 
-    bool operation_end = false;
+Node* ParseOperation(TokenCursor &tokens, int start, int file_end, Node *left, int minimum_precedence)
+{
+    // Operands and pending operators are kept on explicit stacks, so long chains of operators do not recurse
+    vector<Node*> operands = { left };
+    vector<pair<string, int>> operators = {};
 
-    while (!operation_end)
+    while (tokens.size() != 0 && tokens[0]->kind == OperatorToken)
     {
-        if (tokens[0]->type != "Operator")
+        string operator_string = ((Operator*)tokens[0])->value;
+
+        int precedence = GetOperatorPrecedence(operator_string);
+
+        if (precedence == 0)
         {
-            operation_end = true;
-            break;
+            ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid character in operation"});
         }
 
-        operators.push_back(((Operator*)(tokens[0]))->value);
+        if (precedence < minimum_precedence)
+        {
+            break;
+        }
 
-        if (EraseFront(&tokens, 1))
+        if (tokens.Advance(1))
         {
             ThrowError(start, file_end, Error {SyntaxError, "Missing right expression for operation"});
         }
 
-        vector<Node*> data;
-
-        tie(data, tokens) = AnalyseSyntax(tokens, { {}, true });
+        vector<Node*> data = ParseStatements(tokens, { {}, true });
 
         if (tokens.size() == 0 && StatementStarted(data))
         {
@@ -1693,145 +1683,64 @@ pair<Operation*, vector<Token*>> ProcessOperations(pair<vector<pair<Token*, bool
         {
             ThrowError(start, tokens[0]->end, Error {SyntaxError, "Invalid character in operation"});
         }
-        else if (GetASTEnd(data)->type == "StatementEnd")
+        else if (GetASTEnd(data)->kind == StatementEndNode)
         {
             ThrowError(start, data[0]->end, Error {SyntaxError, "Missing right expression for operation"});
         }
 
-        values.push_back(data[0]);
-    }
-
-    Operation *operation = new Operation(operators[0], values[0], NULL);
-
-    for (int i = 1; i < operators.size(); i++)
-    {
-        Node *ending = NULL;
-        
-        if (i == operators.size() - 1)
-        {
-            ending = values[values.size() - 1];
-        }
-
-        if (CompareOperator(operation->operator_string, operators[i]))
+        // Pending operators that bind at least as tightly take their operands first, so operators on the same level associate to the left
+        while (operators.size() != 0 && get<1>(operators.back()) >= precedence)
         {
-            Operation *current_op = operation;
-
-            while (current_op->right != NULL)
-            {
-                current_op = (Operation*)current_op->right;
-            }
-
-            current_op->right = values[i];
-
-            //operation->right = values[i];
-            operation = new Operation(operators[i], operation, ending);
+            ReduceOperation(tokens, operands, operators);
         }
-        else
-        {
-            Operation *current_op = operation;
-
-            while (true)
-            {
-                if (current_op->right == NULL)
-                {
-                    current_op->right = new Operation(operators[i], values[i], ending);
-                    break;
-                }
-                
-                if (CompareOperator(((Operation*)current_op->right)->operator_string, operators[i]))
-                {
-                    Operation *op = (Operation*)current_op->right;
-                    op->right = values[i];
-                    current_op->right = new Operation(operators[i], op, ending);
 
-                    break;
-                }
-                else
-                {
-                    current_op = (Operation*)current_op->right;
-                }
-            }
-        }
+        operators.push_back({operator_string, precedence});
+        operands.push_back(data[0]);
     }
 
-    if (operation->right == NULL)
+    while (operators.size() != 0)
     {
-        operation->right = values[values.size() - 1];
+        ReduceOperation(tokens, operands, operators);
     }
 
-    AddStartAndEnd(operation);
-
-    return {operation, tokens};
+    return operands[0];
 }
 
-bool CompareOperator(string operator1, string operator2)
+void ReduceOperation(TokenCursor &tokens, vector<Node*> &operands, vector<pair<string, int>> &operators)
 {
-    smatch m;
+    Node *right = operands.back();
+    operands.pop_back();
 
-    int op1_level;
-    int op2_level;
+    Node *left = operands.back();
+    operands.pop_back();
 
-    for (int i = 0; i < Operator_Preference.size(); i++)
-    {
-        if (regex_search(operator1, m, regex(Operator_Preference[i])))
-        {
-            op1_level = i;
-        }
+    Operation *operation = tokens.arena->Create(Operation(get<0>(operators.back()), left, right));
+    operators.pop_back();
 
-        if (regex_search(operator2, m, regex(Operator_Preference[i])))
-        {
-            op2_level = i;
-        }
-    }
+    operation->start = left->start;
+    operation->end = right->end;
 
-    return op1_level <= op2_level;
+    operands.push_back(operation);
 }
 
-void AddStartAndEnd(Operation *operation)
+TokenCursor::TokenCursor(vector<Token*> tokens, NodeArena &arena) : tokens(tokens), position(0), arena(&arena)
 {
-    if (InMultiExpression(operation->left))
-    {
-        AddStartAndEnd((Operation*)operation->left);
-    }
-    
-    operation->start = operation->left->start;
-
-    if (InMultiExpression(operation->right))
-    {
-        AddStartAndEnd((Operation*)operation->right);
-    }
 
-    operation->end = operation->right->end;
 }
 
-bool InMultiExpression(Node *node)
+Token* TokenCursor::operator[](int index)
 {
-    if (node->type != "Operation")
-    {
-        return false;
-    }
-
-    Operation *operation = (Operation*)node;
-
-    if (operation->operator_string == "^" || operation->left == NULL)
-    {
-        return false;
-    }
-
-    return true;
+    return tokens[position + index];
 }
 
-bool EraseFront(vector<Token*> *tokens, int length)
+int TokenCursor::size()
 {
-    for (int i = 0; i < length; i++)
-    {
-        tokens->erase(tokens->begin());
+    return tokens.size() - position;
+}
 
-        if (tokens->size() == 0)
-        {
-            return true;
-        }
-    }
+bool TokenCursor::Advance(int length)
+{
+    position = min(position + length, (int)tokens.size());
 
-    return tokens->size() == 0;
+    return size() == 0;
 }
\ No newline at end of file
@@ -7,24 +7,38 @@
 #include "token.hpp"
 #include "node.hpp"
 
-std::pair<std::vector<Node*>, std::vector<Token*>> AnalyseSyntax(std::vector<Token*> tokens, std::pair<std::vector<std::pair<Token*, bool>>, bool> return_flags = { {}, false });
+class TokenCursor
+{
+    public:
+        std::vector<Token*> tokens;
+        int position;
+        NodeArena *arena;
 
-Node* GetASTEnd(std::vector<Node*> AST);
+        TokenCursor(std::vector<Token*> tokens, NodeArena &arena);
 
-bool ShouldReturn(Token *current_token, std::vector<std::pair<Token*, bool>> return_tokens);
+        Token* operator[](int index);
 
-bool StatementStarted(std::vector<Node*> AST);
+        int size();
 
-std::vector<std::pair<Token*, bool>> GetReturnTokens(std::vector<Token*> new_return_tokens, std::vector<std::pair<Token*, bool>> existing_return_tokens);
+        bool Advance(int length);
+};
 
-std::pair<Operation*, std::vector<Token*>> ProcessOperations(std::pair<std::vector<std::pair<Token*, bool>>, bool> return_flags, int start, std::vector<Token*> tokens, Node *left);
+std::pair<std::vector<Node*>, std::vector<Token*>> AnalyseSyntax(std::vector<Token*> tokens, NodeArena &arena = DefaultArena, std::pair<std::vector<std::pair<Token*, bool>>, bool> return_flags = { {}, false });
 
-bool CompareOperator(std::string operator1, std::string operator2);
+std::vector<Node*> ParseStatements(TokenCursor &tokens, const std::pair<std::vector<std::pair<Token*, bool>>, bool> &return_flags);
 
-void AddStartAndEnd(Operation *operation);
+Node* GetASTEnd(const std::vector<Node*> &AST);
 
-bool InMultiExpression(Node *node);
+bool ShouldReturn(Token *current_token, const std::vector<std::pair<Token*, bool>> &return_tokens);
 
-bool EraseFront(std::vector<Token*> *tokens, int length);
+bool StatementStarted(const std::vector<Node*> &AST);
+
+std::vector<std::pair<Token*, bool>> GetReturnTokens(std::vector<Token*> new_return_tokens, const std::vector<std::pair<Token*, bool>> &existing_return_tokens);
+
+int GetOperatorPrecedence(std::string operator_string);
+
+Node* ParseOperation(TokenCursor &tokens, int start, int file_end, Node *left, int minimum_precedence);
+
+void ReduceOperation(TokenCursor &tokens, std::vector<Node*> &operands, std::vector<std::pair<std::string, int>> &operators);
 
 #endif
\ No newline at end of file
@@ -11,75 +11,83 @@ vector<string> Keywords = { "public", "static", "const", "class", "new", "if", "
 
 ostream &operator<<(ostream &os, const Token &t)
 {
-    if (t.type == "Integer")
+    switch (t.kind)
     {
-        return os << (Integer&)t;
-    }
-    else if (t.type == "Float")
-    {
-        return os << (Float&)t;
-    }
-    else if (t.type == "String")
-    {
-        return os << (String&)t;
-    }
-    else if (t.type == "Boolean")
-    {
-        return os << (Boolean&)t;
-    }
-    else if (t.type == "Identifier")
-    {
-        return os << (Identifier&)t;
-    }
-    else if (t.type == "Keyword")
-    {
-        return os << (Keyword&)t;
-    }
-    else if (t.type == "Control")
-    {
-        return os << (Control&)t;
-    }
-    else if (t.type == "Bracket")
-    {
-        return os << (Bracket&)t;
-    }
-    else if (t.type == "Operator")
-    {
-        return os << (Operator&)t;
+        case IntegerToken:
+        {
+            return os << (Integer&)t;
+        }
+        case FloatToken:
+        {
+            return os << (Float&)t;
+        }
+        case StringToken:
+        {
+            return os << (String&)t;
+        }
+        case BooleanToken:
+        {
+            return os << (Boolean&)t;
+        }
+        case IdentifierToken:
+        {
+            return os << (Identifier&)t;
+        }
+        case KeywordToken:
+        {
+            return os << (Keyword&)t;
+        }
+        case ControlToken:
+        {
+            return os << (Control&)t;
+        }
+        case BracketToken:
+        {
+            return os << (Bracket&)t;
+        }
+        case OperatorToken:
+        {
+            return os << (Operator&)t;
+        }
     }
     
     return os;
 }
 
+Token::Token()
+{
+    this->kind = EmptyToken;
+}
+
 bool Token::operator==(const Token &other)
 {
-    if (this->type != other.type)
+    if (this->kind != other.kind)
     {
         return false;
     }
 
-    if (this->type == "Keyword")
+    if (this->kind == KeywordToken)
     {
         if (((Keyword*)this)->name != ((Keyword&)other).name)
         {
             return false;
         }
     }
-    else if (this->type == "Control")
+    else if (this->kind == ControlToken)
     {
         if (((Control*)this)->value != ((Control&)other).value)
         {
             return false;
         }
     }
-    else if (this->type == "Bracket")
+    else if (this->kind == BracketToken)
     {
         if (((Bracket*)this)->value != ((Bracket&)other).value)
         {
             return false;
         }
     }
-    else if (this->type == "Operator")
+    else if (this->kind == OperatorToken)
     {
         if (((Operator*)this)->value == "")
         {
@@ -97,7 +105,7 @@ bool Token::operator==(const Token &other)
 
 Integer::Integer(int number) : number(number)
 {
-    this->type = "Integer";
+    this->kind = IntegerToken;
 }
 
 ostream &operator<<(ostream &os, const Integer &i)
@@ -107,7 +115,7 @@ ostream &operator<<(ostream &os, const Integer &i)
 
 Float::Float(double number) : number(number)
 {
-    this->type = "Float";
+    this->kind = FloatToken;
 }
 
 ostream &operator<<(ostream &os, const Float &f)
@@ -117,7 +125,7 @@ ostream &operator<<(ostream &os, const Float &f)
 
 String::String(string content) : content(content)
 {
-    this->type = "String";
+    this->kind = StringToken;
 }
 
 ostream &operator<<(ostream &os, const String &s)
@@ -127,7 +135,7 @@ ostream &operator<<(ostream &os, const String &s)
 
 Boolean::Boolean(bool boolean) : boolean(boolean)
 {
-    this->type = "Boolean";
+    this->kind = BooleanToken;
 }
 
 ostream &operator<<(ostream &os, const Boolean &b)
@@ -137,7 +145,7 @@ ostream &operator<<(ostream &os, const Boolean &b)
 
 Identifier::Identifier(string name) : name(name)
 {
-    this->type = "Identifier";
+    this->kind = IdentifierToken;
 }
 
 ostream &operator<<(ostream &os, const Identifier &id)
@@ -147,7 +155,7 @@ ostream &operator<<(ostream &os, const Identifier &id)
 
 Keyword::Keyword(string name) : name(name)
 {
-    this->type = "Keyword";
+    this->kind = KeywordToken;
 }
 
 ostream &operator<<(ostream &os, const Keyword &k)
@@ -157,7 +165,7 @@ ostream &operator<<(ostream &os, const Keyword &k)
 
 Control::Control(string value) : value(value)
 {
-    this->type = "Control";
+    this->kind = ControlToken;
 }
 
 ostream &operator<<(ostream &os, const Control &c)
@@ -167,7 +175,7 @@ ostream &operator<<(ostream &os, const Control &c)
 
 Bracket::Bracket(string value) : value(value)
 {
-    this->type = "Bracket";
+    this->kind = BracketToken;
 }
 
 ostream &operator<<(ostream &os, const Bracket &b)
@@ -177,7 +185,7 @@ ostream &operator<<(ostream &os, const Bracket &b)
 
 Operator::Operator(string value) : value(value)
 {
-    this->type = "Operator";
+    this->kind = OperatorToken;
 }
 
 ostream &operator<<(ostream &os, const Operator &o)
@@ -187,41 +195,44 @@ ostream &operator<<(ostream &os, const Operator &o)
 
 tuple<string, int, double, bool> GetTokenValue(Token *token)
 {
-    if (token->type == "Integer")
-    {
-        return tuple<string, int, double, bool> { "", ((Integer*)token)->number, 0.0f, false };
-    }
-    else if (token->type == "Float")
-    {
-        return tuple<string, int, double, bool> { "", 0, ((Float*)token)->number, false };
-    }
-    else if (token->type == "String")
-    {
-        return tuple<string, int, double, bool> { ((String*)token)->content, 0, 0.0f, false };
-    }
-    else if (token->type == "Boolean")
-    {
-        return tuple<string, int, double, bool> { "", 0, 0.0f, ((Boolean*)token)->boolean };
-    }
-    else if (token->type == "Identifier")
+    switch (token->kind)
     {
-        return tuple<string, int, double, bool> { ((Identifier*)token)->name, 0, 0.0f, false };
-    }
-    else if (token->type == "Keyword")
-    {
-        return tuple<string, int, double, bool> { ((Keyword*)token)->name, 0, 0.0f, false };
-    }
-    else if (token->type == "Control")
-    {
-        return tuple<string, int, double, bool> { ((Control*)token)->value, 0, 0.0f, false };
-    }
-    else if (token->type == "Bracket")
-    {
-        return tuple<string, int, double, bool> { ((Bracket*)token)->value, 0, 0.0f, false };
-    }
-    else if (token->type == "Operator")
-    {
-        return tuple<string, int, double, bool> { ((Operator*)token)->value, 0, 0.0f, false };
+        case IntegerToken:
+        {
+            return tuple<string, int, double, bool> { "", ((Integer*)token)->number, 0.0f, false };
+        }
+        case FloatToken:
+        {
+            return tuple<string, int, double, bool> { "", 0, ((Float*)token)->number, false };
+        }
+        case StringToken:
+        {
+            return tuple<string, int, double, bool> { ((String*)token)->content, 0, 0.0f, false };
+        }
+        case BooleanToken:
+        {
+            return tuple<string, int, double, bool> { "", 0, 0.0f, ((Boolean*)token)->boolean };
+        }
+        case IdentifierToken:
+        {
+            return tuple<string, int, double, bool> { ((Identifier*)token)->name, 0, 0.0f, false };
+        }
+        case KeywordToken:
+        {
+            return tuple<string, int, double, bool> { ((Keyword*)token)->name, 0, 0.0f, false };
+        }
+        case ControlToken:
+        {
+            return tuple<string, int, double, bool> { ((Control*)token)->value, 0, 0.0f, false };
+        }
+        case BracketToken:
+        {
+            return tuple<string, int, double, bool> { ((Bracket*)token)->value, 0, 0.0f, false };
+        }
+        case OperatorToken:
+        {
+            return tuple<string, int, double, bool> { ((Operator*)token)->value, 0, 0.0f, false };
+        }
     }
 
     return tuple<string, int, double, bool> { "", 0, 0.0f, false };
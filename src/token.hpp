@@ -10,15 +10,31 @@
 
 extern std::vector<std::string> Keywords;
 
+enum TOKEN_KIND
+{
+    EmptyToken,
+    IntegerToken,
+    FloatToken,
+    StringToken,
+    BooleanToken,
+    IdentifierToken,
+    KeywordToken,
+    ControlToken,
+    BracketToken,
+    OperatorToken,
+};
+
 class Token
 {
     public:
         std::optional<Error> error;
 
-        std::string type;
+        TOKEN_KIND kind;
         int start;
         int end;
 
+        Token();
+
         friend std::ostream &operator<<(std::ostream &os, const Token &t);
 
         bool operator==(const Token &other);
@@ -0,0 +1,520 @@
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "vm.hpp"
+#include "compiler.hpp"
+#include "interpreter.hpp"
+#include "object.hpp"
+#include "node.hpp"
+#include "error.hpp"
+
+using namespace std;
+
+Frame::Frame(shared_ptr<Chunk> chunk, shared_ptr<Environment> env, int stack_base, FRAME_TYPE frame_type, Node *node, shared_ptr<Object> instance) : chunk(chunk), ip(0), env(env), base_env(env), stack_base(stack_base), frame_type(frame_type), node(node), instance(instance)
+{
+
+}
+
+VirtualMachine::VirtualMachine()
+{
+
+}
+
+Value VirtualMachine::Run(shared_ptr<Chunk> chunk, shared_ptr<Environment> env)
+{
+    // Run is re-entrant (default arguments are evaluated with a nested Run), so it only
+    // returns once every frame it pushed has finished
+    int entry_frames = frames.size();
+    int entry_stack = stack.size();
+
+    frames.push_back(Frame(chunk, env, stack.size(), ScriptFrame, NULL, NULL));
+
+    try
+    {
+        while (true)
+        {
+            Frame *frame = &frames.back();
+
+            Instruction instruction = frame->chunk->code[frame->ip++];
+
+            Node *node = instruction.node >= 0 ? frame->chunk->nodes[instruction.node] : NULL;
+
+            switch (instruction.op)
+            {
+                case OpPushVoid:
+                {
+                    Push(Value());
+
+                    break;
+                }
+                case OpPop:
+                {
+                    Pop();
+
+                    break;
+                }
+                case OpConstant:
+                {
+                    Push(frame->chunk->constants[instruction.operand]);
+
+                    break;
+                }
+                case OpType:
+                {
+                    Push(Value(shared_ptr<Object>(new TypeObject(InterpretType(*(TypeExpression*)node, frame->env)))));
+
+                    break;
+                }
+                case OpFunction:
+                {
+                    shared_ptr<FunctionObject> function = InterpretCodeBlock((CodeBlock*)node, frame->env);
+
+                    function->chunk = frame->chunk->chunks[instruction.operand];
+
+                    Push(Value(function));
+
+                    break;
+                }
+                case OpGetVariable:
+                {
+                    GetVariable *get_variable = (GetVariable*)node;
+
+                    Variable *var = frame->env->Find(get_variable->name, instruction.operand, instruction.slot);
+
+                    if (!var)
+                    {
+                        throw ErrorObject(get_variable->start, get_variable->end, Error {IdentifierError, "Identifier '" + get_variable->name + "' is not defined"});
+                    }
+
+                    Push(var->value);
+
+                    break;
+                }
+                case OpDeclareVariable:
+                {
+                    DeclareVariable *declare_variable = (DeclareVariable*)node;
+
+                    Value value = Pop();
+
+                    // A resolved declaration only has to look at its own slot
+                    if (instruction.slot >= 0 ? frame->env->slots[instruction.slot].value.tag != EmptyValue : frame->env->Declares(declare_variable->name))
+                    {
+                        throw ErrorObject(declare_variable->start, declare_variable->end, Error {IdentifierError, "Identifier '" + declare_variable->name + "' is already declared"});
+                    }
+
+                    InterpretDeclaration(declare_variable, value, frame->env, instruction.slot);
+
+                    Push(Value());
+
+                    break;
+                }
+                case OpBinary:
+                {
+                    Value *operands = &stack[stack.size() - 2];
+
+                    FunctionObject *operation_func = GetOperatorMethod((Operation*)node, operands[0], operands[1]);
+
+                    // Builtin operators read their operands straight off the stack without a call frame or environment
+                    if (operation_func->body.index() == 1)
+                    {
+                        Value result = get<1>(operation_func->body)(operands, 2);
+
+                        stack.resize(stack.size() - 2);
+
+                        Push(result);
+
+                        break;
+                    }
+
+                    Value right = Pop();
+                    Value left = Pop();
+
+                    Invoke(operation_func, { Variable(right, Qualifier()) }, left, frame->env, FunctionFrame, node, NULL);
+
+                    break;
+                }
+                case OpUnary:
+                {
+                    Value right = Pop();
+
+                    FunctionObject *operation_func = GetOperatorMethod((Operation*)node, Value(), right);
+
+                    if (operation_func->body.index() == 1)
+                    {
+                        Push(get<1>(operation_func->body)(&right, 1));
+
+                        break;
+                    }
+
+                    Invoke(operation_func, {}, right, frame->env, FunctionFrame, node, NULL);
+
+                    break;
+                }
+                case OpAssign:
+                {
+                    AssignValue(node, Pop(), frame->env, instruction.operand, instruction.slot);
+
+                    Push(Value());
+
+                    break;
+                }
+                case OpGetFunction:
+                {
+                    Push(Value(GetFunction((FunctionCall*)node, frame->env, instruction.operand, instruction.slot)));
+
+                    break;
+                }
+                case OpCall:
+                case OpTailCall:
+                {
+                    FunctionCall *function_call = (FunctionCall*)node;
+
+                    shared_ptr<Object> func = stack[stack.size() - instruction.operand - 1].object;
+
+                    shared_ptr<Environment> env = frame->env;
+
+                    vector<Variable> argument_values = CollectArguments((FunctionObject*)func.get(), function_call, function_call->arguments, instruction.operand, env);
+
+                    // Default arguments run in a nested Run that can grow frames, so the current frame is fetched again
+                    frame = &frames.back();
+
+                    Pop();
+
+                    // A tail call replaces the function frame it returns from, constructors still need their frame to finish.
+                    // A name that resolved to another function at run time may still read the frame, so it is called normally.
+                    if (instruction.op == OpTailCall && frame->frame_type == FunctionFrame && ((FunctionObject*)func.get())->chunk == frame->chunk)
+                    {
+                        env = frame->base_env->parent_environment;
+
+                        stack.resize(frame->stack_base);
+                        frames.pop_back();
+                    }
+
+                    Invoke((FunctionObject*)func.get(), argument_values, optional<Value>(), env, FunctionFrame, node, NULL);
+
+                    break;
+                }
+                case OpClass:
+                {
+                    // TODO: Add interfaces
+
+                    shared_ptr<Chunk> class_chunk = frame->chunk->chunks[instruction.operand];
+
+                    shared_ptr<Environment> class_env = shared_ptr<Environment>(new Environment(frame->env, class_chunk->slot_count));
+                    class_env->slot_names = class_chunk->slot_names;
+
+                    frames.push_back(Frame(class_chunk, class_env, stack.size(), ClassFrame, node, NULL));
+
+                    break;
+                }
+                case OpGetClass:
+                {
+                    Push(Value(GetClassDefinition((InstanceClass*)node, frame->env)));
+
+                    break;
+                }
+                case OpNew:
+                {
+                    InstanceClass *instance_class = (InstanceClass*)node;
+
+                    shared_ptr<Object> class_type = stack[stack.size() - instruction.operand - 1].object;
+
+                    TypeDefinitionObject *definition = (TypeDefinitionObject*)class_type.get();
+
+                    shared_ptr<Object> instance = CreateInstance(class_type);
+
+                    FunctionObject *constructor = GetConstructor(instance_class, definition);
+
+                    if (!constructor)
+                    {
+                        stack.resize(stack.size() - instruction.operand - 1);
+
+                        Push(Value(instance));
+
+                        break;
+                    }
+
+                    shared_ptr<Environment> env = frame->env;
+
+                    shared_ptr<Environment> constructor_env = CreateConstructorEnvironment(definition, instance, env);
+
+                    vector<Variable> argument_values = CollectArguments(constructor, instance_class, instance_class->arguments, instruction.operand, env);
+
+                    Pop();
+
+                    Invoke(constructor, argument_values, optional<Value>(), constructor_env, ConstructorFrame, node, instance);
+
+                    break;
+                }
+                case OpGetMember:
+                {
+                    Push(GetMemberValue((MemberAccess*)node, frame->env, instruction.operand, instruction.slot));
+
+                    break;
+                }
+                case OpMemberEnter:
+                {
+                    frame->env = CreateMemberAccessEnvironment((MemberAccess*)node, frame->env, instruction.operand, instruction.slot);
+
+                    break;
+                }
+                case OpMemberExit:
+                {
+                    frame->env = frame->env->parent_environment;
+
+                    break;
+                }
+                case OpScopeEnter:
+                {
+                    frame->env = shared_ptr<Environment>(new Environment(frame->env, instruction.operand));
+                    frame->env->slot_names = frame->chunk->scope_names[instruction.slot];
+
+                    break;
+                }
+                case OpScopeExit:
+                {
+                    for (int i = 0; i < instruction.operand; i++)
+                    {
+                        frame->env = frame->env->parent_environment;
+                    }
+
+                    break;
+                }
+                case OpJump:
+                {
+                    frame->ip = instruction.operand;
+
+                    break;
+                }
+                case OpJumpIfFalse:
+                {
+                    Value value = Pop();
+
+                    if (!GetCondition(value, node))
+                    {
+                        frame->ip = instruction.operand;
+                    }
+
+                    break;
+                }
+                case OpCaseCompare:
+                {
+                    Value case_value = stack[stack.size() - 1];
+                    Value switch_value = stack[stack.size() - 2];
+
+                    FunctionObject *operation_func = GetCaseMethod(node, switch_value, case_value);
+
+                    if (operation_func->body.index() == 1)
+                    {
+                        Push(get<1>(operation_func->body)(&stack[stack.size() - 2], 2));
+
+                        break;
+                    }
+
+                    Invoke(operation_func, { Variable(case_value, Qualifier()) }, switch_value, frame->env, FunctionFrame, node, NULL);
+
+                    break;
+                }
+                case OpCaseTest:
+                {
+                    Value result = Pop();
+                    Value case_value = Pop();
+
+                    if (!GetCaseResult(node, result, stack.back(), case_value))
+                    {
+                        frame->ip = instruction.operand;
+                    }
+
+                    break;
+                }
+                case OpReturn:
+                {
+                    Value value = Pop();
+
+                    Frame finished = frames.back();
+
+                    frames.pop_back();
+                    stack.resize(finished.stack_base);
+
+                    value = FinishCall(finished.frame_type, finished.node, finished.base_env, finished.instance, value);
+
+                    if (frames.size() == entry_frames)
+                    {
+                        return value;
+                    }
+
+                    Push(value);
+
+                    break;
+                }
+            }
+        }
+    }
+    catch (ErrorObject error)
+    {
+        // Frames pushed by nested runs were already added to the trace when they unwound
+        for (int i = frames.size() - 1; i >= entry_frames; i--)
+        {
+            if (frames[i].node != NULL && (frames[i].frame_type == FunctionFrame || frames[i].frame_type == ConstructorFrame))
+            {
+                error.stack_trace.push_back(TraceFrame {GetCallName(frames[i].node), frames[i].node->start, frames[i].node->end});
+            }
+        }
+
+        frames.erase(frames.begin() + entry_frames, frames.end());
+        stack.resize(entry_stack);
+
+        throw error;
+    }
+}
+
+void VirtualMachine::Push(Value value)
+{
+    stack.push_back(value);
+}
+
+Value VirtualMachine::Pop()
+{
+    Value value = stack.back();
+
+    stack.pop_back();
+
+    return value;
+}
+
+vector<Variable> VirtualMachine::CollectArguments(FunctionObject *function, Node *call, vector<Node*> arguments, int argument_count, shared_ptr<Environment> env)
+{
+    int base = stack.size() - argument_count;
+
+    vector<Variable> argument_values = {};
+
+    // TODO: Deal with array and map arguments (* and **)
+
+    for (int i = 0; i < function->parameters.size(); i++)
+    {
+        if (i >= argument_count)
+        {
+            Parameter &parameter = function->parameters[i];
+
+            if (!parameter.default_argument)
+            {
+                ThrowTooFewArguments(function, call);
+            }
+
+            if (parameter.default_value)
+            {
+                argument_values.push_back(Variable(parameter.default_value.value(), Qualifier()));
+
+                continue;
+            }
+
+            Node *default_argument = parameter.default_argument.value();
+
+            if (default_arguments.find(default_argument) == default_arguments.end())
+            {
+                default_arguments.insert({default_argument, CompileExpression(default_argument)});
+            }
+
+            Value value = Run(default_arguments[default_argument], env);
+
+            if (IsConstantExpression(default_argument))
+            {
+                parameter.default_value = value;
+            }
+
+            argument_values.push_back(Variable(value, Qualifier()));
+        }
+        else
+        {
+            CheckArgument(function->parameters[i], stack[base + i], arguments[i]);
+
+            argument_values.push_back(Variable(stack[base + i], Qualifier()));
+        }
+    }
+
+    stack.resize(base);
+
+    return argument_values;
+}
+
+void VirtualMachine::Invoke(FunctionObject *function, vector<Variable> argument_values, optional<Value> self, shared_ptr<Environment> env, FRAME_TYPE frame_type, Node *node, shared_ptr<Object> instance)
+{
+    if (function->body.index() == 1)
+    {
+        vector<Value> arguments = {};
+
+        if (self)
+        {
+            arguments.push_back(self.value());
+        }
+
+        for (Variable &argument : argument_values)
+        {
+            arguments.push_back(argument.value);
+        }
+
+        Push(FinishCall(frame_type, node, env, instance, get<1>(function->body)(arguments.data(), arguments.size())));
+
+        return;
+    }
+
+    if (function->body.index() == 0 && !function->chunk)
+    {
+        function->chunk = Compile(get<0>(function->body));
+    }
+
+    int slot_count = function->parameters.size();
+
+    if (function->chunk && function->chunk->slot_count > slot_count)
+    {
+        slot_count = function->chunk->slot_count;
+    }
+
+    // Script calls only take space in the frame vector, the limit stops runaway recursion before it exhausts memory
+    if (frames.size() > Max_Call_Depth)
+    {
+        throw ErrorObject(node->start, node->end, Error {RecursionError, "Maximum recursion depth exceeded"});
+    }
+
+    shared_ptr<Environment> func_env = shared_ptr<Environment>(new Environment(env, slot_count));
+
+    // Chunks compiled without a layout, from a body the tree-walker built, still place the arguments first
+    func_env->slot_names = function->chunk->slot_names ? function->chunk->slot_names : function->parameter_names;
+
+    for (int i = 0; i < argument_values.size() && i < function->parameters.size(); i++)
+    {
+        func_env->Set(i, function->parameters[i].name, argument_values[i]);
+    }
+
+    if (self)
+    {
+        func_env->Add("this", Variable(self.value(), Qualifier()));
+    }
+
+    frames.push_back(Frame(function->chunk, func_env, stack.size(), frame_type, node, instance));
+}
+
+Value VirtualMachine::FinishCall(FRAME_TYPE frame_type, Node *node, shared_ptr<Environment> base_env, shared_ptr<Object> instance, Value value)
+{
+    if (frame_type == ClassFrame)
+    {
+        DefineClass((ClassDefinition*)node, base_env, base_env->parent_environment);
+
+        return Value();
+    }
+    else if (frame_type == ConstructorFrame)
+    {
+        return Value(instance);
+    }
+
+    return value;
+}
+
+Value Execute(shared_ptr<Chunk> chunk, shared_ptr<Environment> env)
+{
+    VirtualMachine vm = VirtualMachine();
+
+    return vm.Run(chunk, env);
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef vm_hpp
+#define vm_hpp
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <optional>
+
+#include "compiler.hpp"
+#include "object.hpp"
+#include "node.hpp"
+
+enum FRAME_TYPE
+{
+    ScriptFrame,
+    FunctionFrame,
+    ClassFrame,
+    ConstructorFrame,
+};
+
+class Frame
+{
+    public:
+        std::shared_ptr<Chunk> chunk;
+        int ip;
+        std::shared_ptr<Environment> env;
+        std::shared_ptr<Environment> base_env;
+        int stack_base;
+        FRAME_TYPE frame_type;
+        Node *node;
+        std::shared_ptr<Object> instance;
+
+        Frame(std::shared_ptr<Chunk> chunk, std::shared_ptr<Environment> env, int stack_base, FRAME_TYPE frame_type, Node *node, std::shared_ptr<Object> instance);
+};
+
+class VirtualMachine
+{
+    public:
+        std::vector<Value> stack;
+        std::vector<Frame> frames;
+        std::map<Node*, std::shared_ptr<Chunk>> default_arguments;
+
+        VirtualMachine();
+
+        Value Run(std::shared_ptr<Chunk> chunk, std::shared_ptr<Environment> env);
+
+        void Push(Value value);
+
+        Value Pop();
+
+        std::vector<Variable> CollectArguments(FunctionObject *function, Node *call, std::vector<Node*> arguments, int argument_count, std::shared_ptr<Environment> env);
+
+        void Invoke(FunctionObject *function, std::vector<Variable> argument_values, std::optional<Value> self, std::shared_ptr<Environment> env, FRAME_TYPE frame_type, Node *node, std::shared_ptr<Object> instance);
+
+        Value FinishCall(FRAME_TYPE frame_type, Node *node, std::shared_ptr<Environment> base_env, std::shared_ptr<Object> instance, Value value);
+};
+
+Value Execute(std::shared_ptr<Chunk> chunk, std::shared_ptr<Environment> env);
+
+#endif
\ No newline at end of file
@@ -13,28 +13,28 @@ TEST_CASE("Test Lexer Numbers")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Float" );
+    REQUIRE( tokens[0]->kind == FloatToken );
     REQUIRE( get<2>(GetTokenValue(tokens[0])) == 12.4 );
 
-    REQUIRE( tokens[1]->type == "Float" );
+    REQUIRE( tokens[1]->kind == FloatToken );
     REQUIRE( get<2>(GetTokenValue(tokens[1])) == .5 );
 
-    REQUIRE( tokens[2]->type == "Float" );
+    REQUIRE( tokens[2]->kind == FloatToken );
     REQUIRE( get<2>(GetTokenValue(tokens[2])) == 0. );
 
-    REQUIRE( tokens[3]->type == "Integer" );
+    REQUIRE( tokens[3]->kind == IntegerToken );
     REQUIRE( get<1>(GetTokenValue(tokens[3])) == 2 );
 
-    REQUIRE( tokens[4]->type == "Integer" );
+    REQUIRE( tokens[4]->kind == IntegerToken );
     REQUIRE( get<1>(GetTokenValue(tokens[4])) == 0b010 );
 
-    REQUIRE( tokens[5]->type == "Integer" );
+    REQUIRE( tokens[5]->kind == IntegerToken );
     REQUIRE( get<1>(GetTokenValue(tokens[5])) == 0732 );
 
-    REQUIRE( tokens[6]->type == "Integer" );
+    REQUIRE( tokens[6]->kind == IntegerToken );
     REQUIRE( get<1>(GetTokenValue(tokens[6])) == 0xAF2 );
 
-    REQUIRE( tokens[7]->type == "Integer" );
+    REQUIRE( tokens[7]->kind == IntegerToken );
     REQUIRE( get<1>(GetTokenValue(tokens[7])) == 0xaf2 );
 }
 
@@ -73,13 +73,13 @@ TEST_CASE("Test Lexer Strings")\
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "String" );
+    REQUIRE( tokens[0]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "foo" );
 
-    REQUIRE( tokens[1]->type == "String" );
+    REQUIRE( tokens[1]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == "bar" );
 
-    REQUIRE( tokens[2]->type == "String" );
+    REQUIRE( tokens[2]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == "\nfoobar\n" );
 
 }
@@ -130,22 +130,22 @@ TEST_CASE("Test Lexer Escaping Strings")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "String" );
+    REQUIRE( tokens[0]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "\a \b \f \n \r \t \v" );
 
-    REQUIRE( tokens[1]->type == "String" );
+    REQUIRE( tokens[1]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == ")" ); // The character with code \051
 
-    REQUIRE( tokens[2]->type == "String" );
+    REQUIRE( tokens[2]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == "n" ); // The character with code \x6e
 
-    REQUIRE( tokens[3]->type == "String" );
+    REQUIRE( tokens[3]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[3])) == "嫲" ); // The character with code \u5AF2
 
-    REQUIRE( tokens[4]->type == "String" );
+    REQUIRE( tokens[4]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[4])) == "🨊" ); // The character with code \u0001FA0A
 
-    REQUIRE( tokens[5]->type == "String" );
+    REQUIRE( tokens[5]->kind == StringToken );
     REQUIRE( get<0>(GetTokenValue(tokens[5])) == "\n" );
 }
 
@@ -178,16 +178,16 @@ TEST_CASE("Test Lexer Identifiers")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Identifier" );
+    REQUIRE( tokens[0]->kind == IdentifierToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "foo" );
 
-    REQUIRE( tokens[1]->type == "Identifier" );
+    REQUIRE( tokens[1]->kind == IdentifierToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == "Bar" );
 
-    REQUIRE( tokens[2]->type == "Identifier" );
+    REQUIRE( tokens[2]->kind == IdentifierToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == "g100" );
 
-    REQUIRE_FALSE( tokens[3]->type == "Identifier" ); // Identifiers cannot start with a digit
+    REQUIRE_FALSE( tokens[3]->kind == IdentifierToken ); // Identifiers cannot start with a digit
 }
 
 TEST_CASE("Test Lexer Keywords")
@@ -196,8 +196,20 @@ TEST_CASE("Test Lexer Keywords")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Keyword" );
+    REQUIRE( tokens[0]->kind == KeywordToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "static" );
+
+    for (string keyword : Keywords)
+    {
+        tokens = Tokenise(keyword);
+
+        REQUIRE( tokens[0]->kind == KeywordToken );
+        REQUIRE( get<0>(GetTokenValue(tokens[0])) == keyword );
+
+        tokens = Tokenise(keyword + "s");
+
+        REQUIRE( tokens[0]->kind == IdentifierToken );
+    }
 }
 
 TEST_CASE("Test Lexer Control Characters")
@@ -206,13 +218,13 @@ TEST_CASE("Test Lexer Control Characters")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Control" );
+    REQUIRE( tokens[0]->kind == ControlToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "." );
 
-    REQUIRE( tokens[1]->type == "Control" );
+    REQUIRE( tokens[1]->kind == ControlToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == "," );
 
-    REQUIRE( tokens[2]->type == "Control" );
+    REQUIRE( tokens[2]->kind == ControlToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == ";" );
 }
 
@@ -222,22 +234,22 @@ TEST_CASE("Test Lexer Bracket Characters")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Bracket" );
+    REQUIRE( tokens[0]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "(" );
 
-    REQUIRE( tokens[1]->type == "Bracket" );
+    REQUIRE( tokens[1]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == ")" );
 
-    REQUIRE( tokens[2]->type == "Bracket" );
+    REQUIRE( tokens[2]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == "[" );
 
-    REQUIRE( tokens[3]->type == "Bracket" );
+    REQUIRE( tokens[3]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[3])) == "]" );
 
-    REQUIRE( tokens[4]->type == "Bracket" );
+    REQUIRE( tokens[4]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[4])) == "{" );
 
-    REQUIRE( tokens[5]->type == "Bracket" );
+    REQUIRE( tokens[5]->kind == BracketToken );
     REQUIRE( get<0>(GetTokenValue(tokens[5])) == "}" );
 }
 
@@ -247,67 +259,67 @@ TEST_CASE("Test Lexer Operator Characters")
 
     vector<Token*> tokens = Tokenise(text);
 
-    REQUIRE( tokens[0]->type == "Operator" );
+    REQUIRE( tokens[0]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[0])) == "==" );
 
-    REQUIRE( tokens[1]->type == "Operator" );
+    REQUIRE( tokens[1]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[1])) == "!=" );
 
-    REQUIRE( tokens[2]->type == "Operator" );
+    REQUIRE( tokens[2]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[2])) == "<=" );
 
-    REQUIRE( tokens[3]->type == "Operator" );
+    REQUIRE( tokens[3]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[3])) == ">=" );
 
-    REQUIRE( tokens[4]->type == "Operator" );
+    REQUIRE( tokens[4]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[4])) == "+=" );
 
-    REQUIRE( tokens[5]->type == "Operator" );
+    REQUIRE( tokens[5]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[5])) == "-=" );
 
-    REQUIRE( tokens[6]->type == "Operator" );
+    REQUIRE( tokens[6]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[6])) == "*=" );
 
-    REQUIRE( tokens[7]->type == "Operator" );
+    REQUIRE( tokens[7]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[7])) == "/=" );
 
-    REQUIRE( tokens[8]->type == "Operator" );
+    REQUIRE( tokens[8]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[8])) == "+" );
 
-    REQUIRE( tokens[9]->type == "Operator" );
+    REQUIRE( tokens[9]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[9])) == "-" );
 
-    REQUIRE( tokens[10]->type == "Operator" );
+    REQUIRE( tokens[10]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[10])) == "*" );
 
-    REQUIRE( tokens[11]->type == "Operator" );
+    REQUIRE( tokens[11]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[11])) == "/" );
 
-    REQUIRE( tokens[12]->type == "Operator" );
+    REQUIRE( tokens[12]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[12])) == "$" );
 
-    REQUIRE( tokens[13]->type == "Operator" );
+    REQUIRE( tokens[13]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[13])) == "%" );
 
-    REQUIRE( tokens[14]->type == "Operator" );
+    REQUIRE( tokens[14]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[14])) == "^" );
 
-    REQUIRE( tokens[15]->type == "Operator" );
+    REQUIRE( tokens[15]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[15])) == "=" );
 
-    REQUIRE( tokens[16]->type == "Operator" );
+    REQUIRE( tokens[16]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[16])) == "<" );
 
-    REQUIRE( tokens[17]->type == "Operator" );
+    REQUIRE( tokens[17]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[17])) == ">" );
 
-    REQUIRE( tokens[18]->type == "Operator" );
+    REQUIRE( tokens[18]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[18])) == "!" );
 
-    REQUIRE( tokens[19]->type == "Operator" );
+    REQUIRE( tokens[19]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[19])) == "&" );
 
-    REQUIRE( tokens[20]->type == "Operator" );
+    REQUIRE( tokens[20]->kind == OperatorToken );
     REQUIRE( get<0>(GetTokenValue(tokens[20])) == "|" );
 }
 
@@ -324,4 +336,27 @@ TEST_CASE("Test Lexer Invalid Characters")
 
     REQUIRE( tokens[0]->error->type == SyntaxError );
     REQUIRE( tokens[0]->error->text == "Invalid character" );
+}
+
+TEST_CASE("Test Lexer Token Positions")
+{
+    string text = "if (trueish) { x0 += 0x1F; } // done";
+    vector<Token*> tokens = Tokenise(text);
+
+    REQUIRE( tokens.size() == 11 );
+
+    vector<pair<int, int>> positions = { {0, 2}, {3, 4}, {4, 8}, {8, 11}, {11, 12}, {13, 14}, {15, 17}, {18, 20}, {21, 25}, {25, 26}, {27, 28} };
+
+    for (int i = 0; i < positions.size(); i++)
+    {
+        REQUIRE( tokens[i]->start == positions[i].first );
+        REQUIRE( tokens[i]->end == positions[i].second );
+    }
+
+    REQUIRE( tokens[2]->kind == BooleanToken );
+    REQUIRE( tokens[3]->kind == IdentifierToken );
+    REQUIRE( get<0>(GetTokenValue(tokens[3])) == "ish" );
+
+    REQUIRE( tokens[8]->kind == IntegerToken );
+    REQUIRE( get<1>(GetTokenValue(tokens[8])) == 31 );
 }
\ No newline at end of file
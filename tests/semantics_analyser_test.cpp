@@ -12,34 +12,34 @@ TEST_CASE("Test Semantics Analyser Semicolons")
     string text = "a; b; c;";
     vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
 
-    REQUIRE( AST[0]->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[0])->name == "a" );
-    REQUIRE( AST[1]->type == "GetVariable" );
+    REQUIRE( AST[1]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[1])->name == "b" );
-    REQUIRE( AST[2]->type == "GetVariable" );
+    REQUIRE( AST[2]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[2])->name == "c" );
 
     text = "a;; b;";
     AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
 
-    REQUIRE( AST[0]->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[0])->name == "a" );
-    REQUIRE( AST[1]->type == "GetVariable" );
+    REQUIRE( AST[1]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[1])->name == "b" );
 
     text = "0; if (true) {} 0; 1;";
     AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
 
-    REQUIRE( AST[0]->type == "Literal" );
+    REQUIRE( AST[0]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[0])->l_integer == 0 );
-    REQUIRE( AST[1]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[1])->if_expression->type == "Literal" );
+    REQUIRE( AST[1]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[1])->if_expression->kind == LiteralNode );
     REQUIRE( ((Literal*)((IfStatement*)AST[1])->if_expression)->l_boolean == true );
-    REQUIRE( ((IfStatement*)AST[1])->if_code_block->type == "CodeBlock" );
+    REQUIRE( ((IfStatement*)AST[1])->if_code_block->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((IfStatement*)AST[1])->if_code_block)->content.size() == 0 );
-    REQUIRE( AST[2]->type == "Literal" );
+    REQUIRE( AST[2]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[2])->l_integer == 0 );
-    REQUIRE( AST[3]->type == "Literal" );
+    REQUIRE( AST[3]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[3])->l_integer == 1 );
 
     text = "0 1; 2;";
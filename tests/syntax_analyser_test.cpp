@@ -1,3 +1,5 @@
+#include <sstream>
+
 #include "catch.hpp"
 
 #include "../src/node.hpp"
@@ -12,21 +14,21 @@ TEST_CASE("Test Syntax Analyser Type Expressions")
 
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "TypeExpression" );
+    REQUIRE( AST[0]->kind == TypeExpressionNode );
     REQUIRE( ((TypeExpression*)AST[0])->name == "foo" );
     REQUIRE( ((TypeExpression*)AST[0])->content[0].name == "bar" );
 
-    REQUIRE( AST[1]->type == "TypeExpression" );
+    REQUIRE( AST[1]->kind == TypeExpressionNode );
     REQUIRE( ((TypeExpression*)AST[1])->name == "test" );
     REQUIRE( ((TypeExpression*)AST[1])->content[0].name == "a" );
     REQUIRE( ((TypeExpression*)AST[1])->content[1].name == "b" );
     REQUIRE( ((TypeExpression*)AST[1])->content[2].name == "c" );
 
-    REQUIRE( AST[2]->type == "TypeExpression" );
+    REQUIRE( AST[2]->kind == TypeExpressionNode );
     REQUIRE( ((TypeExpression*)AST[2])->name == "foo" );
     REQUIRE( ((TypeExpression*)AST[2])->is_array );
 
-    REQUIRE( AST[3]->type == "TypeExpression" );
+    REQUIRE( AST[3]->kind == TypeExpressionNode );
     REQUIRE( ((TypeExpression*)AST[3])->name == "this" );
     REQUIRE( ((TypeExpression*)AST[3])->content[0].name == "is" );
     REQUIRE( ((TypeExpression*)AST[3])->content[0].content[0].name == "a" );
@@ -86,19 +88,19 @@ TEST_CASE("Test Syntax Analyser Qualifier Expressions")
     string text = "public public static public static const;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "QualifierExpression" );
+    REQUIRE( AST[0]->kind == QualifierExpressionNode );
     REQUIRE( ((QualifierExpression*)AST[0])->qualifiers == vector<string> { "public" } );
 
-    REQUIRE( AST[1]->type == "QualifierExpression" );
+    REQUIRE( AST[1]->kind == QualifierExpressionNode );
     REQUIRE( ((QualifierExpression*)AST[1])->qualifiers == vector<string> { "public", "static" } );
 
-    REQUIRE( AST[2]->type == "QualifierExpression" );
+    REQUIRE( AST[2]->kind == QualifierExpressionNode );
     REQUIRE( ((QualifierExpression*)AST[2])->qualifiers == vector<string> { "public", "static", "const" } );
 
     text = "const static public;";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "QualifierExpression" );
+    REQUIRE( AST[0]->kind == QualifierExpressionNode );
     REQUIRE_FALSE( ((QualifierExpression*)AST[0])->qualifiers == vector<string> { "const", "static", "public" } ); // Qualifiers must be written in the correct order
 
     text = "public";
@@ -120,13 +122,13 @@ TEST_CASE("Test Syntax Analyser Literals")
 
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "Literal" );
+    REQUIRE( AST[0]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[0])->l_integer.value() == 23 );
 
-    REQUIRE( AST[1]->type == "Literal" );
+    REQUIRE( AST[1]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[1])->l_float.value() == 5.2 );
 
-    REQUIRE( AST[2]->type == "Literal" );
+    REQUIRE( AST[2]->kind == LiteralNode );
     REQUIRE( ((Literal*)AST[2])->l_string.value() == "foo" );
 }
 
@@ -136,35 +138,35 @@ TEST_CASE("Test Syntax Analyser Code Block")
 
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "CodeBlock" );
+    REQUIRE( AST[0]->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)AST[0])->return_type.name == "void" );
     REQUIRE( ((CodeBlock*)AST[0])->parameters.size() == 0 );
-    REQUIRE( ((CodeBlock*)AST[0])->content[0]->type == "Literal" );
+    REQUIRE( ((CodeBlock*)AST[0])->content[0]->kind == LiteralNode );
 
-    REQUIRE( AST[2]->type == "CodeBlock" );
+    REQUIRE( AST[2]->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)AST[2])->return_type.name == "void" );
     REQUIRE( ((CodeBlock*)AST[2])->parameters.size() == 0 );
-    REQUIRE( ((CodeBlock*)AST[2])->content[0]->type == "Literal" );
+    REQUIRE( ((CodeBlock*)AST[2])->content[0]->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)AST[2])->content[0])->l_string == "foo" );
 
-    REQUIRE( AST[4]->type == "CodeBlock" );
+    REQUIRE( AST[4]->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)AST[4])->return_type.name == "void" );
     REQUIRE( ((CodeBlock*)AST[4])->parameters[0].type_data.name == "int" );
     REQUIRE( ((CodeBlock*)AST[4])->parameters[0].name == "foo" );
-    REQUIRE( ((CodeBlock*)AST[4])->content[0]->type == "Literal" );
+    REQUIRE( ((CodeBlock*)AST[4])->content[0]->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)AST[4])->content[0])->l_string == "bar" );
 
-    REQUIRE( AST[6]->type == "CodeBlock" );
+    REQUIRE( AST[6]->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)AST[6])->return_type.name == "string" );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[0].type_data.name == "int" );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[0].name == "foo" );
-    REQUIRE( ((CodeBlock*)AST[6])->parameters[0].default_argument.value()->type == "Literal" );
+    REQUIRE( ((CodeBlock*)AST[6])->parameters[0].default_argument.value()->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)AST[6])->parameters[0].default_argument.value())->l_integer == 0 );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[0].argument_expansion == Array );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[1].type_data.name == "float" );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[1].name == "bar" );
     REQUIRE( ((CodeBlock*)AST[6])->parameters[1].argument_expansion == Dictionary );
-    REQUIRE( ((CodeBlock*)AST[6])->content[0]->type == "Literal" );
+    REQUIRE( ((CodeBlock*)AST[6])->content[0]->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)AST[6])->content[0])->l_string == "foobar" );
 }
 
@@ -457,119 +459,119 @@ TEST_CASE("Test Syntax Analyser Operation") // All needs to change for order of
     string text = "a ^ b; -a; a * b; a + b; a == b; a & b; a | b; a = b; a * b + c; a + b * c; a + b * c == d; a == b * c + d; func(a < b);";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "Operation" );
+    REQUIRE( AST[0]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[0])->operator_string == "^" );
-    REQUIRE( ((Operation*)AST[0])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[0])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[0])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[0])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[0])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[0])->right)->name == "b" );
 
-    REQUIRE( AST[2]->type == "Operation" );
+    REQUIRE( AST[2]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[2])->operator_string == "-" );
     REQUIRE( ((Operation*)AST[2])->left == NULL );
-    REQUIRE( ((Operation*)AST[2])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[2])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[2])->right)->name == "a" );
 
-    REQUIRE( AST[4]->type == "Operation" );
+    REQUIRE( AST[4]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[4])->operator_string == "*" );
-    REQUIRE( ((Operation*)AST[4])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[4])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[4])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[4])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[4])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[4])->right)->name == "b" );
 
-    REQUIRE( AST[6]->type == "Operation" );
+    REQUIRE( AST[6]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[6])->operator_string == "+" );
-    REQUIRE( ((Operation*)AST[6])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[6])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[6])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[6])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[6])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[6])->right)->name == "b" );
 
-    REQUIRE( AST[8]->type == "Operation" );
+    REQUIRE( AST[8]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[8])->operator_string == "==" );
-    REQUIRE( ((Operation*)AST[8])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[8])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[8])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[8])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[8])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[8])->right)->name == "b" );
 
-    REQUIRE( AST[10]->type == "Operation" );
+    REQUIRE( AST[10]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[10])->operator_string == "&" );
-    REQUIRE( ((Operation*)AST[10])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[10])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[10])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[10])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[10])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[10])->right)->name == "b" );
 
-    REQUIRE( AST[12]->type == "Operation" );
+    REQUIRE( AST[12]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[12])->operator_string == "|" );
-    REQUIRE( ((Operation*)AST[12])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[12])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[12])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[12])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[12])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[12])->right)->name == "b" );
 
-    REQUIRE( AST[14]->type == "Operation" );
+    REQUIRE( AST[14]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[14])->operator_string == "=" );
-    REQUIRE( ((Operation*)AST[14])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[14])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[14])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[14])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[14])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[14])->right)->name == "b" );
 
-    REQUIRE( AST[16]->type == "Operation" );
+    REQUIRE( AST[16]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[16])->operator_string == "+" );
-    REQUIRE( ((Operation*)AST[16])->left->type == "Operation" );
+    REQUIRE( ((Operation*)AST[16])->left->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)AST[16])->left)->operator_string == "*" );
-    REQUIRE( ((Operation*)((Operation*)AST[16])->left)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[16])->left)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[16])->left)->left)->name == "a" );
-    REQUIRE( ((Operation*)((Operation*)AST[16])->left)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[16])->left)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[16])->left)->right)->name == "b" );
-    REQUIRE( ((Operation*)AST[16])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[16])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[16])->right)->name == "c" );
 
-    REQUIRE( AST[18]->type == "Operation" );
+    REQUIRE( AST[18]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[18])->operator_string == "+" );
-    REQUIRE( ((Operation*)AST[18])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[18])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[18])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[18])->right->type == "Operation" );
+    REQUIRE( ((Operation*)AST[18])->right->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)AST[18])->right)->operator_string == "*" );
-    REQUIRE( ((Operation*)((Operation*)AST[18])->right)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[18])->right)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[18])->right)->left)->name == "b" );
-    REQUIRE( ((Operation*)((Operation*)AST[18])->right)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[18])->right)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[18])->right)->right)->name == "c" );
 
-    REQUIRE( AST[20]->type == "Operation" );
+    REQUIRE( AST[20]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[20])->operator_string == "==" );
-    REQUIRE( ((Operation*)AST[20])->left->type == "Operation" );
+    REQUIRE( ((Operation*)AST[20])->left->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)AST[20])->left)->operator_string == "+" );
-    REQUIRE( ((Operation*)((Operation*)AST[20])->left)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[20])->left)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[20])->left)->left)->name == "a" );
-    REQUIRE( ((Operation*)((Operation*)AST[20])->left)->right->type == "Operation" );
+    REQUIRE( ((Operation*)((Operation*)AST[20])->left)->right->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->operator_string == "*" );
-    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->left)->name == "b" );
-    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)((Operation*)AST[20])->left)->right)->right)->name == "c" );
-    REQUIRE( ((Operation*)AST[20])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[20])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[20])->right)->name == "d" );
 
-    REQUIRE( AST[22]->type == "Operation" );
+    REQUIRE( AST[22]->kind == OperationNode );
     REQUIRE( ((Operation*)AST[22])->operator_string == "==" );
-    REQUIRE( ((Operation*)AST[22])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)AST[22])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)AST[22])->left)->name == "a" );
-    REQUIRE( ((Operation*)AST[22])->right->type == "Operation" );
+    REQUIRE( ((Operation*)AST[22])->right->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)AST[22])->right)->operator_string == "+" );
-    REQUIRE( ((Operation*)((Operation*)AST[22])->right)->left->type == "Operation" );
+    REQUIRE( ((Operation*)((Operation*)AST[22])->right)->left->kind == OperationNode );
     REQUIRE( ((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->operator_string == "*" );
-    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->left)->name == "b" );
-    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)((Operation*)AST[22])->right)->left)->right)->name == "c" );
-    REQUIRE( ((Operation*)((Operation*)AST[22])->right)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((Operation*)AST[22])->right)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((Operation*)AST[22])->right)->right)->name == "d" );
 
-    REQUIRE( AST[24]->type == "FunctionCall" );
-    REQUIRE( ((FunctionCall*)AST[24])->arguments[0]->type == "Operation" );
+    REQUIRE( AST[24]->kind == FunctionCallNode );
+    REQUIRE( ((FunctionCall*)AST[24])->arguments[0]->kind == OperationNode );
     REQUIRE( ((Operation*)((FunctionCall*)AST[24])->arguments[0])->operator_string == "<" );
-    REQUIRE( (((Operation*)((FunctionCall*)AST[24])->arguments[0])->left)->type == "GetVariable" );
+    REQUIRE( (((Operation*)((FunctionCall*)AST[24])->arguments[0])->left)->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)(((Operation*)((FunctionCall*)AST[24])->arguments[0])->left))->name == "a" );
-    REQUIRE( (((Operation*)((FunctionCall*)AST[24])->arguments[0])->right)->type == "GetVariable" );
+    REQUIRE( (((Operation*)((FunctionCall*)AST[24])->arguments[0])->right)->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)(((Operation*)((FunctionCall*)AST[24])->arguments[0])->right))->name == "b" );
 
     text = "> a";
@@ -671,16 +673,58 @@ TEST_CASE("Test Syntax Analyser Operation") // All needs to change for order of
     }
 }
 
+TEST_CASE("Test Syntax Analyser Operator Precedence")
+{
+    vector<pair<string, string>> expressions = {
+        { "x = 1 + 2 * 3 - 4;", "(x=((1+(2*3))-4))" },
+        { "a - b - c;", "((a-b)-c)" },
+        { "a ^ b ^ c * d;", "(((a^b)^c)*d)" },
+        { "-a ^ b * c;", "((-(a^b))*c)" },
+        { "a * -b ^ c;", "(a*(-(b^c)))" },
+        { "a | b & c == d + e * f ^ g;", "(a|(b&(c==(d+(e*(f^g))))))" },
+    };
+
+    for (pair<string, string> expression : expressions)
+    {
+        vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(expression.first)));
+
+        stringstream s;
+        s << *AST[0];
+
+        REQUIRE( s.str() == expression.second );
+        REQUIRE( AST[0]->start == 0 );
+        REQUIRE( AST[0]->end == expression.first.size() - 1 );
+    }
+}
+
+TEST_CASE("Test Syntax Analyser Node Arena")
+{
+    NodeArena arena;
+
+    vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise("int x = a + 1;"), arena));
+
+    REQUIRE( arena.nodes.size() == 7 );
+    REQUIRE( arena.blocks.size() == 1 );
+    REQUIRE( AST.back() == arena.nodes.back() );
+    REQUIRE( (char*)AST[0] >= arena.blocks[0] );
+    REQUIRE( (char*)AST[0] < arena.blocks[0] + arena.block_used );
+
+    arena.Release();
+
+    REQUIRE( arena.nodes.size() == 0 );
+    REQUIRE( arena.blocks.size() == 0 );
+}
+
 TEST_CASE("Test Syntax Analyser Get Variable")
 {
     string text = "foo; bar;";
 
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[0])->name == "foo" );
 
-    REQUIRE( AST[2]->type == "GetVariable" );
+    REQUIRE( AST[2]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)AST[2])->name == "bar" );
 
     text = "test() foo;";
@@ -703,26 +747,26 @@ TEST_CASE("Test Syntax Analyser Assign Variable")
     string text = "int foo = 0;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "Literal" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == LiteralNode );
     REQUIRE( ((Literal*)((DeclareVariable*)AST[0])->value)->l_integer == 0 );
 
     text = "static const int foo = 0;";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->qualifier->qualifiers == vector<string> { "static", "const" } );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "Literal" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == LiteralNode );
     REQUIRE( ((Literal*)((DeclareVariable*)AST[0])->value)->l_integer == 0 );
 
     text = "int foo;";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
     REQUIRE( ((DeclareVariable*)AST[0])->value == NULL );
@@ -730,7 +774,7 @@ TEST_CASE("Test Syntax Analyser Assign Variable")
     text = "static const int foo;";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->qualifier->qualifiers == vector<string> { "static", "const" } );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
@@ -784,20 +828,20 @@ TEST_CASE("Test Syntax Analyser Function Call")
     string text = "foo(); bar(0.); foobar(a + b);";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "FunctionCall" );
+    REQUIRE( AST[0]->kind == FunctionCallNode );
     REQUIRE( ((FunctionCall*)AST[0])->name == "foo" );
     REQUIRE( ((FunctionCall*)AST[0])->arguments.size() == 0 );
 
-    REQUIRE( AST[2]->type == "FunctionCall" );
+    REQUIRE( AST[2]->kind == FunctionCallNode );
     REQUIRE( ((FunctionCall*)AST[2])->name == "bar" );
     REQUIRE( ((Literal*)((FunctionCall*)AST[2])->arguments[0])->l_float == 0. );
     
-    REQUIRE( AST[4]->type == "FunctionCall" );
+    REQUIRE( AST[4]->kind == FunctionCallNode );
     REQUIRE( ((FunctionCall*)AST[4])->name == "foobar" );
     REQUIRE( ((Operation*)((FunctionCall*)AST[4])->arguments[0])->operator_string == "+" );
-    REQUIRE( ((Operation*)((FunctionCall*)AST[4])->arguments[0])->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((FunctionCall*)AST[4])->arguments[0])->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((FunctionCall*)AST[4])->arguments[0])->left)->name == "a" );
-    REQUIRE( ((Operation*)((FunctionCall*)AST[4])->arguments[0])->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((FunctionCall*)AST[4])->arguments[0])->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((FunctionCall*)AST[4])->arguments[0])->right)->name == "b" );
 
     text = "foo(";
@@ -862,10 +906,10 @@ TEST_CASE("Test Syntax Analyser Define Function")
     string text = "int foo() {}";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
@@ -873,10 +917,10 @@ TEST_CASE("Test Syntax Analyser Define Function")
     text = "void foo() {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "void" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
@@ -886,11 +930,11 @@ TEST_CASE("Test Syntax Analyser Define Function")
 
     DeclareVariable a = *((DeclareVariable*)AST[0]);
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->qualifier->qualifiers == vector<string> { "public", "static" } );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
@@ -898,22 +942,22 @@ TEST_CASE("Test Syntax Analyser Define Function")
     text = "int foo() {bar}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
-    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content[0]->type == "GetVariable" );
+    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((CodeBlock*)((DeclareVariable*)AST[0])->value)->content[0])->name == "bar" );
 
     text = "int foo(string bar) {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].type_data.name == "string" );
@@ -922,24 +966,24 @@ TEST_CASE("Test Syntax Analyser Define Function")
     text = "int foo(string bar = 'abc') {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].type_data.name == "string" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].name == "bar" );
-    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value()->type == "Literal" );
+    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value()->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value())->l_string == "abc" );
 
     text = "int foo(string **bar) {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].type_data.name == "string" );
@@ -949,15 +993,15 @@ TEST_CASE("Test Syntax Analyser Define Function")
     text = "int foo(string *bar = 'abc') {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)AST[0])->variable_type.name == "Function" );
     REQUIRE( ((DeclareVariable*)AST[0])->name == "foo" );
-    REQUIRE( ((DeclareVariable*)AST[0])->value->type == "CodeBlock" );
+    REQUIRE( ((DeclareVariable*)AST[0])->value->kind == CodeBlockNode );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->return_type.name == "int" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content.size() == 0 );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].type_data.name == "string" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].name == "bar" );
-    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value()->type == "Literal" );
+    REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value()->kind == LiteralNode );
     REQUIRE( ((Literal*)((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].default_argument.value())->l_string == "abc" );
     REQUIRE( ((CodeBlock*)((DeclareVariable*)AST[0])->value)->parameters[0].argument_expansion == Array );
 }
@@ -967,19 +1011,19 @@ TEST_CASE("Test Syntax Analyser Class Definition")
     string text = "class foo { int test; } class foo : bar { int test; }";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "ClassDefinition" );
+    REQUIRE( AST[0]->kind == ClassDefinitionNode );
     REQUIRE( ((ClassDefinition*)AST[0])->name == "foo" );
     REQUIRE( ((ClassDefinition*)AST[0])->interface == "" );
     REQUIRE( ((ClassDefinition*)AST[0])->body.size() == 2 );
-    REQUIRE( ((ClassDefinition*)AST[0])->body[0]->type == "DeclareVariable" );
+    REQUIRE( ((ClassDefinition*)AST[0])->body[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ClassDefinition*)AST[0])->body[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ClassDefinition*)AST[0])->body[0])->name == "test" );
 
-    REQUIRE( AST[1]->type == "ClassDefinition" );
+    REQUIRE( AST[1]->kind == ClassDefinitionNode );
     REQUIRE( ((ClassDefinition*)AST[1])->name == "foo" );
     REQUIRE( ((ClassDefinition*)AST[1])->interface == "bar" );
     REQUIRE( ((ClassDefinition*)AST[1])->body.size() == 2 );
-    REQUIRE( ((ClassDefinition*)AST[1])->body[0]->type == "DeclareVariable" );
+    REQUIRE( ((ClassDefinition*)AST[1])->body[0]->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ClassDefinition*)AST[1])->body[0])->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ClassDefinition*)AST[1])->body[0])->name == "test" );
 
@@ -1129,22 +1173,22 @@ TEST_CASE("Test Syntax Analyser Member Access")
     string text = "foo.bar; foo.bar(); foo.bar.foobar;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "MemberAccess" );
+    REQUIRE( AST[0]->kind == MemberAccessNode );
     REQUIRE( ((MemberAccess*)AST[0])->name == "foo" );
-    REQUIRE( ((MemberAccess*)AST[0])->statement->type == "GetVariable" );
+    REQUIRE( ((MemberAccess*)AST[0])->statement->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((MemberAccess*)AST[0])->statement)->name == "bar" );
 
-    REQUIRE( AST[2]->type == "MemberAccess" );
+    REQUIRE( AST[2]->kind == MemberAccessNode );
     REQUIRE( ((MemberAccess*)AST[2])->name == "foo" );
-    REQUIRE( ((MemberAccess*)AST[2])->statement->type == "FunctionCall" );
+    REQUIRE( ((MemberAccess*)AST[2])->statement->kind == FunctionCallNode );
     REQUIRE( ((FunctionCall*)((MemberAccess*)AST[2])->statement)->name == "bar" );
     REQUIRE( ((FunctionCall*)((MemberAccess*)AST[2])->statement)->arguments.size() == 0 );
 
-    REQUIRE( AST[4]->type == "MemberAccess" );
+    REQUIRE( AST[4]->kind == MemberAccessNode );
     REQUIRE( ((MemberAccess*)AST[4])->name == "foo" );
-    REQUIRE( ((MemberAccess*)AST[4])->statement->type == "MemberAccess" );
+    REQUIRE( ((MemberAccess*)AST[4])->statement->kind == MemberAccessNode );
     REQUIRE( ((MemberAccess*)((MemberAccess*)AST[4])->statement)->name == "bar" );
-    REQUIRE( ((MemberAccess*)((MemberAccess*)AST[4])->statement)->statement->type == "GetVariable" );
+    REQUIRE( ((MemberAccess*)((MemberAccess*)AST[4])->statement)->statement->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((MemberAccess*)((MemberAccess*)AST[4])->statement)->statement)->name == "foobar" );
 
     text = "foo.";
@@ -1237,8 +1281,8 @@ TEST_CASE("Test Syntax Analyser If Statements")
     string text = "if (exp) {}";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[0])->if_expression->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[0])->if_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[0])->if_expression)->name == "exp" );
     REQUIRE( ((IfStatement*)AST[0])->if_code_block->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[0])->else_if_expressions.size() == 0 );
@@ -1248,41 +1292,41 @@ TEST_CASE("Test Syntax Analyser If Statements")
     text = "if (exp) {} if (exp) {} else {} if (exp1) {} else if (exp2) {} if (exp1) {} else if (exp2) {} else if (exp3) {} else {}";
     AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[0])->if_expression->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[0])->if_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[0])->if_expression)->name == "exp" );
     REQUIRE( ((IfStatement*)AST[0])->if_code_block->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[0])->else_if_expressions.size() == 0 );
     REQUIRE( ((IfStatement*)AST[0])->else_if_code_blocks.size() == 0 );
     REQUIRE( ((IfStatement*)AST[0])->else_code_block == NULL );
 
-    REQUIRE( AST[1]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[1])->if_expression->type == "GetVariable" );
+    REQUIRE( AST[1]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[1])->if_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[1])->if_expression)->name == "exp" );
     REQUIRE( ((IfStatement*)AST[1])->if_code_block->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[1])->else_if_expressions.size() == 0 );
     REQUIRE( ((IfStatement*)AST[1])->else_if_code_blocks.size() == 0 );
     REQUIRE( ((IfStatement*)AST[1])->else_code_block->content.size() == 0 );
 
-    REQUIRE( AST[2]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[2])->if_expression->type == "GetVariable" );
+    REQUIRE( AST[2]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[2])->if_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[2])->if_expression)->name == "exp1" );
     REQUIRE( ((IfStatement*)AST[2])->if_code_block->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[2])->else_if_expressions.size() == 1 );
-    REQUIRE( ((IfStatement*)AST[2])->else_if_expressions[0]->type == "GetVariable" );
+    REQUIRE( ((IfStatement*)AST[2])->else_if_expressions[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[2])->else_if_expressions[0])->name == "exp2" );
     REQUIRE( ((IfStatement*)AST[2])->else_if_code_blocks.size() == 1 );
     REQUIRE( ((IfStatement*)AST[2])->else_if_code_blocks[0]->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[0])->else_code_block == NULL );
 
-    REQUIRE( AST[3]->type == "IfStatement" );
-    REQUIRE( ((IfStatement*)AST[3])->if_expression->type == "GetVariable" );
+    REQUIRE( AST[3]->kind == IfStatementNode );
+    REQUIRE( ((IfStatement*)AST[3])->if_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[3])->if_expression)->name == "exp1" );
     REQUIRE( ((IfStatement*)AST[3])->if_code_block->content.size() == 0 );
     REQUIRE( ((IfStatement*)AST[3])->else_if_expressions.size() == 2 );
-    REQUIRE( ((IfStatement*)AST[3])->else_if_expressions[0]->type == "GetVariable" );
+    REQUIRE( ((IfStatement*)AST[3])->else_if_expressions[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[3])->else_if_expressions[0])->name == "exp2" );
-    REQUIRE( ((IfStatement*)AST[3])->else_if_expressions[1]->type == "GetVariable" );
+    REQUIRE( ((IfStatement*)AST[3])->else_if_expressions[1]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((IfStatement*)AST[3])->else_if_expressions[1])->name == "exp3" );
     REQUIRE( ((IfStatement*)AST[3])->else_if_code_blocks.size() == 2 );
     REQUIRE( ((IfStatement*)AST[3])->else_if_code_blocks[0]->content.size() == 0 );
@@ -1519,30 +1563,30 @@ TEST_CASE("Test Syntax Analyser Switch Statement")
     string text = "switch (exp) {} switch (exp1) { case (exp2) {} } switch (exp1) { case (exp2) {} case (exp3) {} default {} }";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "SwitchStatement" );
-    REQUIRE( ((SwitchStatement*)AST[0])->switch_expression->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == SwitchStatementNode );
+    REQUIRE( ((SwitchStatement*)AST[0])->switch_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[0])->switch_expression)->name == "exp" );
     REQUIRE( ((SwitchStatement*)AST[0])->case_expressions.size() == 0 );
     REQUIRE( ((SwitchStatement*)AST[0])->case_code_blocks.size() == 0 );
     REQUIRE( ((SwitchStatement*)AST[0])->default_code_block == NULL );
 
-    REQUIRE( AST[1]->type == "SwitchStatement" );
-    REQUIRE( ((SwitchStatement*)AST[1])->switch_expression->type == "GetVariable" );
+    REQUIRE( AST[1]->kind == SwitchStatementNode );
+    REQUIRE( ((SwitchStatement*)AST[1])->switch_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[1])->switch_expression)->name == "exp1" );
     REQUIRE( ((SwitchStatement*)AST[1])->case_expressions.size() == 1 );
-    REQUIRE( ((SwitchStatement*)AST[1])->case_expressions[0]->type == "GetVariable" );
+    REQUIRE( ((SwitchStatement*)AST[1])->case_expressions[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[1])->case_expressions[0])->name == "exp2" );
     REQUIRE( ((SwitchStatement*)AST[1])->case_code_blocks.size() == 1 );
     REQUIRE( ((SwitchStatement*)AST[1])->case_code_blocks[0]->content.size() == 0 );
     REQUIRE( ((SwitchStatement*)AST[1])->default_code_block == NULL );
 
-    REQUIRE( AST[2]->type == "SwitchStatement" );
-    REQUIRE( ((SwitchStatement*)AST[2])->switch_expression->type == "GetVariable" );
+    REQUIRE( AST[2]->kind == SwitchStatementNode );
+    REQUIRE( ((SwitchStatement*)AST[2])->switch_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[2])->switch_expression)->name == "exp1" );
     REQUIRE( ((SwitchStatement*)AST[2])->case_expressions.size() == 2 );
-    REQUIRE( ((SwitchStatement*)AST[2])->case_expressions[0]->type == "GetVariable" );
+    REQUIRE( ((SwitchStatement*)AST[2])->case_expressions[0]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[2])->case_expressions[0])->name == "exp2" );
-    REQUIRE( ((SwitchStatement*)AST[2])->case_expressions[1]->type == "GetVariable" );
+    REQUIRE( ((SwitchStatement*)AST[2])->case_expressions[1]->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((SwitchStatement*)AST[2])->case_expressions[1])->name == "exp3" );
     REQUIRE( ((SwitchStatement*)AST[2])->case_code_blocks.size() == 2 );
     REQUIRE( ((SwitchStatement*)AST[2])->case_code_blocks[0]->content.size() == 0 );
@@ -1842,6 +1886,14 @@ TEST_CASE("Test Syntax Analyser Switch Statement")
         REQUIRE( node->error->type == SyntaxError );
         REQUIRE( node->error->text == "Missing ending }" );
     }
+
+    text = "switch (foo) { default {} } bar;";
+    AST = get<0>(AnalyseSyntax(Tokenise(text)));
+
+    REQUIRE( AST.size() == 3 );
+    REQUIRE( AST[0]->kind == SwitchStatementNode );
+    REQUIRE( AST[1]->kind == GetVariableNode );
+    REQUIRE( AST[2]->kind == StatementEndNode );
 }
 
 TEST_CASE("Test Syntax Analyser For Loop")
@@ -1849,54 +1901,54 @@ TEST_CASE("Test Syntax Analyser For Loop")
     string text = "for (;;) {} for (int i = 0;;) {} for (int i = 0; i < length;) {} for (int i = 0; i < length; i += 1) {}";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "ForLoop" );
+    REQUIRE( AST[0]->kind == ForLoopNode );
     REQUIRE( ((ForLoop*)AST[0])->declaration_expression == NULL );
     REQUIRE( ((ForLoop*)AST[0])->condition_expression == NULL );
     REQUIRE( ((ForLoop*)AST[0])->iteration_expression == NULL );
     REQUIRE( ((ForLoop*)AST[0])->for_code_block->content.size() == 0 );
 
-    REQUIRE( AST[1]->type == "ForLoop" );
-    REQUIRE( ((ForLoop*)AST[1])->declaration_expression->type == "DeclareVariable" );
+    REQUIRE( AST[1]->kind == ForLoopNode );
+    REQUIRE( ((ForLoop*)AST[1])->declaration_expression->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[1])->declaration_expression)->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[1])->declaration_expression)->name == "i" );
-    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[1])->declaration_expression)->value->type == "Literal" );
+    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[1])->declaration_expression)->value->kind == LiteralNode );
     REQUIRE( ((Literal*)((DeclareVariable*)((ForLoop*)AST[1])->declaration_expression)->value)->l_integer == 0 );
     REQUIRE( ((ForLoop*)AST[1])->condition_expression == NULL );
     REQUIRE( ((ForLoop*)AST[1])->iteration_expression == NULL );
     REQUIRE( ((ForLoop*)AST[1])->for_code_block->content.size() == 0 );
 
-    REQUIRE( AST[2]->type == "ForLoop" );
-    REQUIRE( ((ForLoop*)AST[2])->declaration_expression->type == "DeclareVariable" );
+    REQUIRE( AST[2]->kind == ForLoopNode );
+    REQUIRE( ((ForLoop*)AST[2])->declaration_expression->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[2])->declaration_expression)->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[2])->declaration_expression)->name == "i" );
-    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[2])->declaration_expression)->value->type == "Literal" );
+    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[2])->declaration_expression)->value->kind == LiteralNode );
     REQUIRE( ((Literal*)((DeclareVariable*)((ForLoop*)AST[2])->declaration_expression)->value)->l_integer == 0 );
-    REQUIRE( ((ForLoop*)AST[2])->condition_expression->type == "Operation" );
+    REQUIRE( ((ForLoop*)AST[2])->condition_expression->kind == OperationNode );
     REQUIRE( ((Operation*)((ForLoop*)AST[2])->condition_expression)->operator_string == "<" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[2])->condition_expression)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[2])->condition_expression)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((ForLoop*)AST[2])->condition_expression)->left)->name == "i" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[2])->condition_expression)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[2])->condition_expression)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((ForLoop*)AST[2])->condition_expression)->right)->name == "length" );
     REQUIRE( ((ForLoop*)AST[2])->iteration_expression == NULL );
     REQUIRE( ((ForLoop*)AST[2])->for_code_block->content.size() == 0 );
 
-    REQUIRE( AST[3]->type == "ForLoop" );
-    REQUIRE( ((ForLoop*)AST[3])->declaration_expression->type == "DeclareVariable" );
+    REQUIRE( AST[3]->kind == ForLoopNode );
+    REQUIRE( ((ForLoop*)AST[3])->declaration_expression->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[3])->declaration_expression)->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ForLoop*)AST[3])->declaration_expression)->name == "i" );
-    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[3])->declaration_expression)->value->type == "Literal" );
+    REQUIRE( ((DeclareVariable*)((ForLoop*)AST[3])->declaration_expression)->value->kind == LiteralNode );
     REQUIRE( ((Literal*)((DeclareVariable*)((ForLoop*)AST[3])->declaration_expression)->value)->l_integer == 0 );
-    REQUIRE( ((ForLoop*)AST[3])->condition_expression->type == "Operation" );
+    REQUIRE( ((ForLoop*)AST[3])->condition_expression->kind == OperationNode );
     REQUIRE( ((Operation*)((ForLoop*)AST[3])->condition_expression)->operator_string == "<" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[3])->condition_expression)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[3])->condition_expression)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((ForLoop*)AST[3])->condition_expression)->left)->name == "i" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[3])->condition_expression)->right->type == "GetVariable" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[3])->condition_expression)->right->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((ForLoop*)AST[3])->condition_expression)->right)->name == "length" );
-    REQUIRE( ((ForLoop*)AST[3])->iteration_expression->type == "Operation" );
+    REQUIRE( ((ForLoop*)AST[3])->iteration_expression->kind == OperationNode );
     REQUIRE( ((Operation*)((ForLoop*)AST[3])->iteration_expression)->operator_string == "+=" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[3])->iteration_expression)->left->type == "GetVariable" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[3])->iteration_expression)->left->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Operation*)((ForLoop*)AST[3])->iteration_expression)->left)->name == "i" );
-    REQUIRE( ((Operation*)((ForLoop*)AST[3])->iteration_expression)->right->type == "Literal" );
+    REQUIRE( ((Operation*)((ForLoop*)AST[3])->iteration_expression)->right->kind == LiteralNode );
     REQUIRE( ((Literal*)((Operation*)((ForLoop*)AST[3])->iteration_expression)->right)->l_integer == 1 );
     REQUIRE( ((ForLoop*)AST[3])->for_code_block->content.size() == 0 );
 
@@ -1994,11 +2046,11 @@ TEST_CASE("Test Syntax Analyser Foreach Loop")
     string text = "for (int item : list) {}";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "ForEachLoop" );
-    REQUIRE( ((ForEachLoop*)AST[0])->declaration_expression->type == "DeclareVariable" );
+    REQUIRE( AST[0]->kind == ForEachLoopNode );
+    REQUIRE( ((ForEachLoop*)AST[0])->declaration_expression->kind == DeclareVariableNode );
     REQUIRE( ((DeclareVariable*)((ForEachLoop*)AST[0])->declaration_expression)->variable_type.name == "int" );
     REQUIRE( ((DeclareVariable*)((ForEachLoop*)AST[0])->declaration_expression)->name == "item" );
-    REQUIRE( ((ForEachLoop*)AST[0])->iteration_expression->type == "GetVariable" );
+    REQUIRE( ((ForEachLoop*)AST[0])->iteration_expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((ForEachLoop*)AST[0])->iteration_expression)->name == "list" );
     REQUIRE( ((ForEachLoop*)AST[0])->for_code_block->content.size() == 0 );
 
@@ -2107,8 +2159,8 @@ TEST_CASE("Test Syntax Analyser While Loop")
     string text = "while (true) {}";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "WhileLoop" );
-    REQUIRE( ((WhileLoop*)AST[0])->condition->type == "Literal" );
+    REQUIRE( AST[0]->kind == WhileLoopNode );
+    REQUIRE( ((WhileLoop*)AST[0])->condition->kind == LiteralNode );
     REQUIRE( ((Literal*)((WhileLoop*)AST[0])->condition)->l_boolean == true );
     REQUIRE( ((WhileLoop*)AST[0])->while_code_block->content.size() == 0 );
 
@@ -2195,8 +2247,8 @@ TEST_CASE("Test Syntax Analyser Return")
     string text = "return foo;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "Return" );
-    REQUIRE( ((Return*)AST[0])->expression->type == "GetVariable" );
+    REQUIRE( AST[0]->kind == ReturnNode );
+    REQUIRE( ((Return*)AST[0])->expression->kind == GetVariableNode );
     REQUIRE( ((GetVariable*)((Return*)AST[0])->expression)->name == "foo" );
 }
 
@@ -2205,7 +2257,7 @@ TEST_CASE("Test Syntax Analyser Break")
     string text = "break;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "Break" );
+    REQUIRE( AST[0]->kind == BreakNode );
 }
 
 TEST_CASE("Test Syntax Analyser Continue")
@@ -2213,5 +2265,48 @@ TEST_CASE("Test Syntax Analyser Continue")
     string text = "continue;";
     vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text)));
 
-    REQUIRE( AST[0]->type == "Continue" );
+    REQUIRE( AST[0]->kind == ContinueNode );
+}
+
+TEST_CASE("Test Syntax Analyser Nesting Depth")
+{
+    string text = "a";
+
+    for (int i = 0; i < 5000; i++)
+    {
+        text += " - a";
+    }
+
+    vector<Node*> AST = get<0>(AnalyseSyntax(Tokenise(text + ";")));
+
+    Node *node = AST[0];
+    int depth = 0;
+
+    while (node->kind == OperationNode)
+    {
+        node = ((Operation*)node)->left;
+        depth++;
+    }
+
+    REQUIRE( depth == 5000 );
+    REQUIRE( node->kind == GetVariableNode );
+
+    text = "";
+
+    for (int i = 0; i < 5000; i++)
+    {
+        text += "if (a) { ";
+    }
+
+    try
+    {
+        AnalyseSyntax(Tokenise(text));
+
+        FAIL();
+    }
+    catch (Node *node)
+    {
+        REQUIRE( node->error->type == RecursionError );
+        REQUIRE( node->error->text == "Maximum nesting depth exceeded" );
+    }
 }
\ No newline at end of file
@@ -0,0 +1,778 @@
+#include <sstream>
+#include <optional>
+
+#include "catch.hpp"
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+
+#include "../src/node.hpp"
+#include "../src/object.hpp"
+#include "../src/lexer.hpp"
+#include "../src/syntax_analyser.hpp"
+#include "../src/semantics_analyser.hpp"
+#include "../src/interpreter.hpp"
+#include "../src/compiler.hpp"
+#include "../src/vm.hpp"
+
+using namespace std;
+
+shared_ptr<Environment> RunVM(string text)
+{
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+
+    Execute(Compile(AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))))), env);
+
+    return env;
+}
+
+// One run of a program, the AST is kept so a test can look at what the run cached on its nodes
+class EngineRun
+{
+    public:
+        vector<Node*> AST;
+        shared_ptr<Environment> env;
+        optional<ErrorObject> error;
+};
+
+// Errors are kept on the run instead of thrown, so a test makes its checks once the run has finished
+EngineRun RunEngine(string text, bool tree_walk)
+{
+    EngineRun run = { AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text)))), InitialiseInterpreterData(), optional<ErrorObject>() };
+
+    try
+    {
+        tree_walk ? (void)Interpret(run.AST, run.env, {}) : (void)Execute(Compile(run.AST), run.env);
+    }
+    catch (ErrorObject error)
+    {
+        run.error = error;
+    }
+
+    return run;
+}
+
+// Runs text on the virtual machine and then on the tree-walker
+vector<EngineRun> RunBoth(string text)
+{
+    return { RunEngine(text, false), RunEngine(text, true) };
+}
+
+string EnvironmentString(shared_ptr<Environment> env)
+{
+    stringstream s;
+    s << *env;
+
+    return s.str();
+}
+
+TEST_CASE("Test VM Matches Tree Walking Interpreter")
+{
+    vector<string> texts = {
+        "int a = 1; int b = a; b = 5; float c = 1.5 * 2.0; bool d = a < b; d = !d;",
+        "int total = 0; for (int i = 0; i < 10; i += 1) { if (i == 2) { continue; } if (i == 6) { break; } total += i; }",
+        "int total = 0; int n = 0; while (n < 5) { n += 1; switch (n) { case (3) { break; } default { total += 100; } } }",
+        "int fib(int x) { if (x < 2) { return x; } return fib(x - 1) + fib(x - 2); } int f = fib(10);",
+        "int twice(int x, int y = 2) { return x * y; } int t = twice(4); int u = twice(4, 3);",
+        "class Foo { int x = 1; void Foo(int v) { x = v; } int get() { return x; } } Foo f = new Foo(7); int g = f.get(); int h = f.x;",
+        "int a = 0; if (a > 0) { a = 1; } else if (a < 0) { a = 2; } else { a = 3; }",
+        "string word = \"a\"; switch (word) { case (\"b\") { word = \"x\"; } case (\"a\") { word = \"y\"; } }",
+        "int a = 1; int total = 0; for (int i = 0; i < 3; i += 1) { if (i == 5) { int a = 2; } total += a; }",
+        "class Counter { int n = 0; void Counter(int start) { n = start; } void inc() { n += 1; } int get() { return n; } } Counter c = new Counter(5); c.inc(); c.inc(); int v = c.get(); int w = c.n;",
+        "int g = 2; int scale(int x) { int y = x * g; return y; } int total = 0; for (int i = 0; i < 3; i += 1) { for (int j = 0; j < 3; j += 1) { total += scale(i + j); } }",
+    };
+
+    for (string text : texts)
+    {
+        vector<EngineRun> runs = RunBoth(text);
+
+        REQUIRE( !runs[0].error );
+        REQUIRE( !runs[1].error );
+        REQUIRE( EnvironmentString(runs[0].env) == EnvironmentString(runs[1].env) );
+    }
+}
+
+TEST_CASE("Test VM Values")
+{
+    shared_ptr<Environment> env = RunVM("int total = 0; for (int i = 0; i < 10; i += 1) { if (i == 2) { continue; } if (i == 6) { break; } total += i; }");
+
+    REQUIRE( env->Get("total")->value.int_value == 13 );
+    REQUIRE( !env->Get("i") );
+
+    env = RunVM("int total = 0; int n = 0; while (n < 5) { n += 1; switch (n) { case (3) { break; } default { total += 100; } } }");
+
+    REQUIRE( env->Get("total")->value.int_value == 200 );
+    REQUIRE( env->Get("n")->value.int_value == 3 );
+
+    env = RunVM("int fib(int x) { if (x < 2) { return x; } return fib(x - 1) + fib(x - 2); } int f = fib(15);");
+
+    REQUIRE( env->Get("f")->value.int_value == 610 );
+
+    env = RunVM("class Foo { int x = 1; void Foo(int v) { x = v; } int get() { return x; } } Foo f = new Foo(7); int g = f.get();");
+
+    REQUIRE( env->Get("g")->value.int_value == 7 );
+
+    env = RunVM("int k = 1; int j = k; j += 4; void bump(int x) { x += 1; } bump(k); string s = \"a\"; string t = s; t += \"b\";");
+
+    REQUIRE( env->Get("k")->value.tag == IntValue );
+    REQUIRE( env->Get("k")->value.int_value == 1 );
+    REQUIRE( env->Get("j")->value.int_value == 5 );
+    REQUIRE( ((StringObject*)env->Get("s")->value.object.get())->value == "a" );
+    REQUIRE( ((StringObject*)env->Get("t")->value.object.get())->value == "ab" );
+
+    env = RunVM("class Counter { int n = 0; void Counter(int start) { n = start; } void inc() { n += 1; } } Counter c = new Counter(5); c.inc(); c.inc(); int v = c.n;");
+
+    REQUIRE( env->Get("v")->value.int_value == 7 );
+
+    // Methods work on the slots of the instance, so a write made through another reference during the call is kept
+    string text = "class P { int x = 1; void bump() { x += 1; } void both() { q.bump(); x += 10; } } P p = new P(); P q = p; p.both(); int r = p.x;";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("r")->value.int_value == 12 );
+    }
+}
+
+TEST_CASE("Test VM Errors")
+{
+    string text = "int a = b;";
+
+    try
+    {
+        RunVM(text);
+
+        FAIL();
+    }
+    catch (ErrorObject error)
+    {
+        REQUIRE( error.error.type == IdentifierError );
+        REQUIRE( error.error.text == "Identifier 'b' is not defined" );
+    }
+
+    text = "int a = 1; float b = 2.0; a + b;";
+
+    try
+    {
+        RunVM(text);
+
+        FAIL();
+    }
+    catch (ErrorObject error)
+    {
+        REQUIRE( error.error.type == TypeError );
+        REQUIRE( error.error.text == "'+' operation cannot be applied to type 'int' and 'float'" );
+    }
+
+    text = "int add(int x, int y) { return x + y; } add(1);";
+
+    try
+    {
+        RunVM(text);
+
+        FAIL();
+    }
+    catch (ErrorObject error)
+    {
+        REQUIRE( error.error.type == FunctionError );
+        REQUIRE( error.error.text == "Expected (int x, int y) too few arguments" );
+    }
+}
+
+TEST_CASE("Test Compiler Resolves Variables")
+{
+    string text = "int a = 1; for (int i = 0; i < 3; i += 1) { int b = i; a += b; }";
+    shared_ptr<Chunk> chunk = Compile(AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text)))));
+
+    vector<pair<string, Instruction>> variables = {};
+
+    for (Instruction instruction : chunk->code)
+    {
+        if (instruction.op == OpGetVariable)
+        {
+            variables.push_back({ ((GetVariable*)chunk->nodes[instruction.node])->name, instruction });
+        }
+    }
+
+    REQUIRE( variables.size() == 5 );
+    REQUIRE( variables[0].first == "i" );
+    REQUIRE( variables[0].second.operand == 0 );
+    REQUIRE( variables[0].second.slot == 0 );
+    REQUIRE( variables[1].first == "i" );
+    REQUIRE( variables[1].second.operand == 1 );
+    REQUIRE( variables[1].second.slot == 0 );
+    REQUIRE( variables[2].first == "a" );
+    REQUIRE( variables[2].second.slot == -1 );
+    REQUIRE( variables[3].first == "b" );
+    REQUIRE( variables[3].second.operand == 0 );
+    REQUIRE( variables[3].second.slot == 0 );
+    REQUIRE( variables[4].first == "i" );
+    REQUIRE( variables[4].second.operand == 0 );
+    REQUIRE( variables[4].second.slot == 0 );
+}
+
+TEST_CASE("Test Compiler Constant Pool")
+{
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+
+    string text = "string s = \"a\"; for (int i = 0; i < 3; i += 1) { string t = \"b\"; t += \"c\"; s += t; }";
+    shared_ptr<Chunk> chunk = Compile(AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text)))));
+
+    REQUIRE( chunk->constants.size() == 6 );
+
+    Execute(chunk, env);
+
+    REQUIRE( ((StringObject*)env->Get("s")->value.object.get())->value == "abcbcbc" );
+    REQUIRE( ((StringObject*)chunk->constants[0].object.get())->value == "a" );
+    REQUIRE( chunk->constants[1].int_value == 0 );
+}
+
+TEST_CASE("Test Operation Inline Cache")
+{
+    vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise("int a = 1; for (int i = 0; i < 3; i += 1) { a = a * 2; } float b = 1.5 * 2.0;"))));
+
+    Operation *int_multiply = (Operation*)((Operation*)((ForLoop*)AST[1])->for_code_block->content[0])->right;
+    Operation *float_multiply = (Operation*)((DeclareVariable*)AST[2])->value;
+
+    REQUIRE( int_multiply->operator_code == MultiplyOperator );
+    REQUIRE( ((Operation*)((ForLoop*)AST[1])->for_code_block->content[0])->operator_code == AssignmentOperator );
+    REQUIRE( int_multiply->cache.size == 0 );
+
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+    Execute(Compile(AST), env);
+
+    REQUIRE( env->Get("a")->value.int_value == 8 );
+    REQUIRE( int_multiply->cache.size == 1 );
+    REQUIRE( int_multiply->cache.types[0] == IntDefinition );
+    REQUIRE( float_multiply->cache.size == 1 );
+    REQUIRE( float_multiply->cache.types[0] == FloatDefinition );
+}
+
+TEST_CASE("Test Builtin Operator Intrinsics")
+{
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+
+    FunctionObject *add = (FunctionObject*)((TypeDefinitionObject*)IntDefinition.get())->GetMember("add")->value.object.get();
+
+    Value operands[] = { Value(2), Value(3) };
+
+    REQUIRE( add->body.index() == 1 );
+    REQUIRE( get<1>(add->body)(operands, 2).int_value == 5 );
+
+    FunctionObject *negative = (FunctionObject*)((TypeDefinitionObject*)FloatDefinition.get())->GetMember("negative")->value.object.get();
+
+    Value operand = Value(1.5f);
+
+    REQUIRE( get<1>(negative->body)(&operand, 1).float_value == -1.5f );
+
+    Execute(Compile(AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise("class Foo { int x = 1; int get() { return x; } }"))))), env);
+
+    FunctionObject *get_method = (FunctionObject*)((TypeDefinitionObject*)env->Get("Foo")->value.object.get())->GetMember("get")->value.object.get();
+
+    REQUIRE( get_method->body.index() == 0 );
+}
+
+TEST_CASE("Test Cached Default Arguments")
+{
+    string text = "int g = 3; int scale(int x, int y = 2 * 5, int z = g) { return x * y + z; } int a = scale(1); g = 4; int b = scale(1);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+
+        FunctionObject *scale = (FunctionObject*)run.env->Get("scale")->value.object.get();
+
+        REQUIRE( run.env->Get("a")->value.int_value == 13 );
+        REQUIRE( run.env->Get("b")->value.int_value == 14 );
+        REQUIRE( scale->parameters[1].default_value );
+        REQUIRE( scale->parameters[1].default_value.value().int_value == 10 );
+        REQUIRE( !scale->parameters[2].default_value );
+    }
+}
+
+TEST_CASE("Test Error Stack Traces")
+{
+    string text = "int inner(int x) { return x + 1.5; } int outer(int y) { return inner(y); } int a = 1; outer(a);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( run.error );
+
+        ErrorObject &error = run.error.value();
+
+        REQUIRE( error.error.type == TypeError );
+        REQUIRE( error.stack_trace.size() == 2 );
+        REQUIRE( error.stack_trace[0].name == "inner" );
+        REQUIRE( error.stack_trace[0].start == 63 );
+        REQUIRE( error.stack_trace[1].name == "outer" );
+        REQUIRE( error.stack_trace[1].start == 86 );
+        REQUIRE( FormatStackTrace(error.stack_trace, { (int)text.size() + 1 }) == vector<string> { "in inner called at line 1", "in outer called at line 1" } );
+    }
+
+    int max_call_depth = Max_Call_Depth;
+    Max_Call_Depth = 100;
+
+    text = "int deep(int n) { return 1 + deep(n + 1); }\nint a = deep(0);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( run.error );
+
+        ErrorObject &error = run.error.value();
+        vector<string> frames = FormatStackTrace(error.stack_trace, { 44, (int)text.size() + 1 });
+
+        REQUIRE( error.error.type == RecursionError );
+        REQUIRE( error.stack_trace.size() > 90 );
+        REQUIRE( frames.size() == 3 );
+        REQUIRE( frames[0] == "in deep called at line 1" );
+        REQUIRE( frames[1] == "... previous frame repeated " + to_string(error.stack_trace.size() - 2) + " more times" );
+        REQUIRE( frames[2] == "in deep called at line 2" );
+    }
+
+    Max_Call_Depth = max_call_depth;
+}
+
+TEST_CASE("Test Tail Calls")
+{
+    string text = "int count(int n, int total) { if (n == 0) { return total; } return count(n - 1, total + 1); } int a = count(100000, 0);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("a")->value.int_value == 100000 );
+    }
+
+    vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
+    vector<Node*> body = ((CodeBlock*)((DeclareVariable*)AST[0])->value)->content;
+
+    REQUIRE( !((Return*)((IfStatement*)body[0])->if_code_block->content[0])->tail_call );
+    REQUIRE( ((Return*)body[1])->tail_call );
+
+    AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise("int f() { return 1; } for (int i = 0; i < 3; i += 1) { return f(); }"))));
+
+    REQUIRE( !((Return*)((ForLoop*)AST[1])->for_code_block->content[0])->tail_call );
+
+    // Callees can read the locals of their caller, so only self calls that declare nothing replace the frame
+    text = "int make(int v) { int g() { return v; } return g(); } int m1 = make(1); "
+        "int twice(int n) { int k = n; if (n == 0) { return k; } return twice(n - 1); } int m2 = twice(0);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("m1")->value.int_value == 1 );
+        REQUIRE( run.env->Get("m2")->value.int_value == 0 );
+    }
+
+    AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
+
+    REQUIRE( !((Return*)((CodeBlock*)((DeclareVariable*)AST[0])->value)->content[1])->tail_call );
+    REQUIRE( !((Return*)((CodeBlock*)((DeclareVariable*)AST[2])->value)->content[2])->tail_call );
+
+    // Default arguments that are not constant are evaluated while the tail call is being made
+    text = "int g = 1; int count(int n, int total, int step = g) { if (n == 0) { return total; } return count(n - 1, total + step); } int a = count(10, 0);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("a")->value.int_value == 10 );
+    }
+}
+
+TEST_CASE("Test Maximum Recursion Depth")
+{
+    string text = "int a = 1";
+
+    for (int i = 0; i < 40000; i++)
+    {
+        text += " + 1";
+    }
+
+    for (EngineRun run : RunBoth(text + ";"))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("a")->value.int_value == 40001 );
+    }
+
+    int max_call_depth = Max_Call_Depth;
+    Max_Call_Depth = 2000;
+
+    text = "int f(int n) { if (n == 0) { return 0; } return 1 + f(n - 1); } int a = f(1990);";
+
+    vector<EngineRun> runs = {};
+    vector<EngineRun> failed_runs = {};
+
+    // The stack is sized from the call depth as in main, so the limit reached does not depend on the size of native frames.
+    // Only the runs happen on its thread, the checks are made here once it has finished.
+    int status = RunWithCallStack(Max_Call_Depth, [&]()
+    {
+        runs = RunBoth(text);
+        failed_runs = RunBoth(text + " int b = f(2010);");
+
+        return 0;
+    });
+
+    REQUIRE( status == 0 );
+
+    for (EngineRun run : runs)
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("a")->value.int_value == 1990 );
+    }
+
+    for (EngineRun run : failed_runs)
+    {
+        REQUIRE( run.error );
+        REQUIRE( run.error->error.type == RecursionError );
+        REQUIRE( run.error->error.text == "Maximum recursion depth exceeded" );
+    }
+
+    Max_Call_Depth = max_call_depth;
+}
+
+TEST_CASE("Test Loop Bodies Without Declarations")
+{
+    string text = "int total = 0; for (int i = 0; i < 10; i += 1) { if (i > 5) { total += i; } } while (total < 100) { if (total > 0) { int step = 10; total += step; } }";
+
+    vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
+
+    REQUIRE( !((ForLoop*)AST[1])->for_code_block->declares );
+    REQUIRE( ((WhileLoop*)AST[2])->while_code_block->declares );
+
+    shared_ptr<Chunk> chunk = Compile(AST);
+    int scopes = 0;
+
+    for (Instruction instruction : chunk->code)
+    {
+        if (instruction.op == OpScopeEnter)
+        {
+            scopes++;
+        }
+    }
+
+    // The for loop keeps the scope of its declaration, only the while body needs one per iteration
+    REQUIRE( scopes == 2 );
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("total")->value.int_value == 100 );
+    }
+}
+
+TEST_CASE("Test Instance Shapes")
+{
+    string text = "class Point { int x = 1; int y = 2; void Point(int a) { x = a; } int sum() { return x + y; } } class Bare { int v = 3; void set(int n) { v = n; } } "
+        "Point p = new Point(5); Bare b = new Bare(); b.set(9);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+
+        TypeDefinitionObject *point = (TypeDefinitionObject*)run.env->Get("Point")->value.object.get();
+        ClassInstanceObject *p = (ClassInstanceObject*)run.env->Get("p")->value.object.get();
+        ClassInstanceObject *b = (ClassInstanceObject*)run.env->Get("b")->value.object.get();
+
+        REQUIRE( point->shape.names.size() == 2 );
+        REQUIRE( point->shape.Find("x") == 0 );
+        REQUIRE( point->shape.Find("y") == 1 );
+        REQUIRE( point->shape.Find("sum") == -1 );
+        REQUIRE( p->slots.size() == 2 );
+        REQUIRE( p->slots[0].value.int_value == 5 );
+        REQUIRE( p->slots[1].value.int_value == 2 );
+        REQUIRE( b->slots[0].value.int_value == 9 );
+    }
+}
+
+TEST_CASE("Test Member Access Cache")
+{
+    string text = "class Point { int x = 1; int y = 2; void Point(int a) { x = a; } int sum() { return x + y; } } Point p = new Point(5); int a = 0; "
+        "for (int i = 0; i < 3; i += 1) { a += p.y; } int b = p.x;";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+
+        MemberAccess *loop_access = (MemberAccess*)((Operation*)((ForLoop*)run.AST[3])->for_code_block->content[0])->right;
+        MemberAccess *access = (MemberAccess*)((DeclareVariable*)run.AST[4])->value;
+
+        REQUIRE( run.env->Get("a")->value.int_value == 6 );
+        REQUIRE( run.env->Get("b")->value.int_value == 5 );
+        REQUIRE( loop_access->cached_class == run.env->Get("Point")->value.object );
+        REQUIRE( loop_access->cached_slot == 1 );
+        REQUIRE( access->cached_slot == 0 );
+    }
+}
+
+TEST_CASE("Test Redeclaration")
+{
+    // Only the scope of the declaration is checked, so recursive calls can declare their own locals
+    string text = "int f(int n) { int c = n; if (n > 0) { return f(n - 1) + c; } return c; } int r = f(3);";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("r")->value.int_value == 6 );
+    }
+
+    for (string redeclared : { "int a = 1; int a = 2;", "int f(int n) { int n = 1; return n; } int r = f(2);" })
+    {
+        for (EngineRun run : RunBoth(redeclared))
+        {
+            REQUIRE( run.error );
+            REQUIRE( run.error->error.type == IdentifierError );
+        }
+    }
+}
+
+TEST_CASE("Test Call Environments Share Slot Names")
+{
+    shared_ptr<Environment> env = RunVM("int f(int a, int b) { int c = a + b; return c; } int x = f(1, 2);");
+
+    FunctionObject *f = (FunctionObject*)env->Get("f")->value.object.get();
+
+    REQUIRE( env->Get("x")->value.int_value == 3 );
+    REQUIRE( f->chunk->slot_names->at("c") == 2 );
+    REQUIRE( f->parameter_names->at("b") == 1 );
+
+    Environment call = Environment(env, f->chunk->slot_count);
+    call.slot_names = f->chunk->slot_names;
+    call.Set(0, "a", Variable(Value(4), Qualifier()));
+
+    // Binding a slot leaves the shared names alone, undeclared slots stay invisible
+    REQUIRE( call.names.empty() );
+    REQUIRE( call.Get("a")->value.int_value == 4 );
+    REQUIRE( !call.Get("c") );
+    REQUIRE( call.Variables().size() == 1 );
+}
+
+TEST_CASE("Test Member Access Objects Are Resolved")
+{
+    string text = "class Point { int x = 1; int get() { return x; } } int f() { Point p = new Point(); int x = p.x; return x + p.get(); } int a = f();";
+
+    vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise(text))));
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+
+    shared_ptr<Chunk> chunk = Compile(AST);
+    Execute(chunk, env);
+
+    REQUIRE( env->Get("a")->value.int_value == 2 );
+
+    int resolved = 0;
+
+    for (shared_ptr<Chunk> function : chunk->chunks)
+    {
+        for (Instruction instruction : function->code)
+        {
+            if (instruction.op == OpGetMember || instruction.op == OpMemberEnter)
+            {
+                REQUIRE( instruction.operand == 0 );
+                REQUIRE( instruction.slot == 0 );
+
+                resolved++;
+            }
+        }
+    }
+
+    REQUIRE( resolved == 2 );
+}
+
+TEST_CASE("Test Heap Collects Instance Cycles")
+{
+    shared_ptr<Environment> env = RunVM("class Link { int v = 0; } Link a = new Link(); Link b = new Link(); Link c = new Link();");
+
+    shared_ptr<Object> a = env->Get("a")->value.object;
+    shared_ptr<Object> b = env->Get("b")->value.object;
+    shared_ptr<Object> c = env->Get("c")->value.object;
+
+    ((ClassInstanceObject*)a.get())->slots[0].value = Value(b);
+    ((ClassInstanceObject*)b.get())->slots[0].value = Value(a);
+    ((ClassInstanceObject*)c.get())->slots[0].value = Value(c);
+
+    weak_ptr<Object> weak_a = a, weak_b = b, weak_c = c;
+
+    a = b = c = NULL;
+
+    REQUIRE( DefaultHeap.Collect(false) == 0 );
+    REQUIRE( ((ClassInstanceObject*)weak_a.lock().get())->heap_generation == 1 );
+
+    env = NULL;
+
+    REQUIRE( !weak_a.expired() );
+    REQUIRE( DefaultHeap.Collect(false) == 0 );
+    REQUIRE( DefaultHeap.Collect(true) == 3 );
+    REQUIRE( weak_a.expired() );
+    REQUIRE( weak_b.expired() );
+    REQUIRE( weak_c.expired() );
+
+    env = RunVM("class Link { int v = 0; } Link d = new Link();");
+
+    ClassInstanceObject *d = (ClassInstanceObject*)env->Get("d")->value.object.get();
+
+    DefaultHeap.Untrack(d);
+
+    {
+        Heap heap;
+        heap.Track(d);
+    }
+
+    // Instances that outlive their heap are released without reaching back into it
+    REQUIRE( d->heap_index == -1 );
+
+    env = NULL;
+}
+
+TEST_CASE("Test Closures Do Not Form Cycles")
+{
+    // Scope is dynamic, so a function that names an instance looks it up on each call instead of holding it or its environment
+    string text = "class Box { int v = 1; int get() { Function<int> value = () -> int { return v; }; return value(); } } "
+                  "int run() { Box b = new Box(); Function<int> read = () -> int { return b.get(); }; return read(); } "
+                  "int total = 0; for (int i = 0; i < 100; i += 1) { total += run(); }";
+
+    long long instances = DefaultAllocator.live_objects[InstanceAllocation];
+    int collections = DefaultHeap.collections;
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+        REQUIRE( run.env->Get("total")->value.int_value == 100 );
+    }
+
+    REQUIRE( DefaultAllocator.live_objects[InstanceAllocation] == instances );
+    REQUIRE( DefaultHeap.collections == collections );
+}
+
+TEST_CASE("Test Slab Allocator")
+{
+    RunVM("int x = 1;");
+
+    long long environments = DefaultAllocator.live_objects[EnvironmentAllocation];
+    long long strings = DefaultAllocator.live_objects[StringAllocation];
+
+    shared_ptr<Environment> env = RunVM("string s = \"a\"; int x = 1;");
+
+    REQUIRE( DefaultAllocator.live_objects[EnvironmentAllocation] > environments );
+    REQUIRE( DefaultAllocator.live_objects[StringAllocation] > strings );
+
+    Environment *released = env.get();
+    env = NULL;
+
+    REQUIRE( DefaultAllocator.live_objects[EnvironmentAllocation] == environments );
+
+#if defined(__SANITIZE_ADDRESS__)
+    REQUIRE( __asan_address_is_poisoned(released) );
+#endif
+
+    Environment *reused = new Environment(NULL, 0);
+
+    REQUIRE( (reused == released || !Slab_Allocation) );
+
+    delete reused;
+}
+
+TEST_CASE("Test Object Kinds")
+{
+    shared_ptr<Environment> env = RunVM("class Foo { int x = 1; int get() { return x; } } Foo f = new Foo(); string s = \"a\";");
+
+    Object *foo = env->Get("Foo")->value.object.get();
+    Object *f = env->Get("f")->value.object.get();
+
+    REQUIRE( ObjectCast<TypeDefinitionObject>(foo) == foo );
+    REQUIRE( ObjectCast<ClassInstanceObject>(f) == f );
+    REQUIRE( ObjectCast<FunctionObject>(f) == NULL );
+    REQUIRE( ObjectCast<FunctionObject>(((TypeDefinitionObject*)foo)->GetMember("get")->value.object.get()) != NULL );
+    REQUIRE( env->Get("s")->value.object->kind == StringObjectKind );
+    REQUIRE( ObjectCast<StringObject>(NULL) == NULL );
+}
+
+TEST_CASE("Test Primitive Values Are Inline")
+{
+    string text = "int total = 0; float scale = 0.5; bool done = false; for (int i = 0; i < 100; i += 1) { total += i; scale = scale + 1.0; done = total > 50; }";
+
+    for (EngineRun run : RunBoth(text))
+    {
+        REQUIRE( !run.error );
+
+        Value total = run.env->Get("total")->value;
+        Value scale = run.env->Get("scale")->value;
+        Value done = run.env->Get("done")->value;
+
+        REQUIRE( total.tag == IntValue );
+        REQUIRE( total.int_value == 4950 );
+        REQUIRE( scale.tag == FloatValue );
+        REQUIRE( scale.float_value == 100.5 );
+        REQUIRE( done.tag == BoolValue );
+        REQUIRE( done.bool_value );
+
+        // Results of arithmetic and comparisons are stored in the Value itself and never boxed
+        REQUIRE( !total.object );
+        REQUIRE( !scale.object );
+        REQUIRE( !done.object );
+    }
+}
+
+TEST_CASE("Test Interpret Expression")
+{
+    vector<Node*> AST = AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise("int a = 2; int b = 3; a + b; for (int i = 0; i < 3; i += 1) { break; }"))));
+    shared_ptr<Environment> env = InitialiseInterpreterData();
+
+    Interpret({ AST[0], AST[1] }, env, {});
+
+    REQUIRE( InterpretExpression(AST[2], env, NULL).int_value == 5 );
+    REQUIRE( InterpretExpression(NULL, env, NULL).tag == VoidValue );
+    REQUIRE( get<1>(InterpretStatement(AST[3], env, NULL)) == EndOfAST );
+    REQUIRE( get<1>(InterpretStatement(((ForLoop*)AST[3])->for_code_block->content[0], env, NULL)) == BreakStatement );
+}
+
+TEST_CASE("Test Shared Function Prototypes")
+{
+    string text = "int total = 0; for (int i = 0; i < 3; i += 1) { int add(int a, int b = 1) { return a + b; } total += add(i); }";
+
+    // Every initialisation replaces the builtin classes, so each run is checked before the next one starts
+    for (bool tree_walk : { false, true })
+    {
+        EngineRun run = RunEngine(text, tree_walk);
+
+        REQUIRE( !run.error );
+
+        CodeBlock *code_block = (CodeBlock*)((DeclareVariable*)((ForLoop*)run.AST[1])->for_code_block->content[0])->value;
+        shared_ptr<FunctionObject> prototype = code_block->prototype;
+
+        REQUIRE( run.env->Get("total")->value.int_value == 6 );
+        REQUIRE( prototype );
+        REQUIRE( InterpretCodeBlock(code_block, run.env) == prototype );
+
+        // Reinitialising replaces the builtin classes, so the parameter types no longer match
+        run.env = InitialiseInterpreterData();
+
+        REQUIRE( InterpretCodeBlock(code_block, run.env) != prototype );
+    }
+}
+
+TEST_CASE("Test Cached Types")
+{
+    string text = "class Foo { int v = 1; } Foo f = new Foo(); int total = 0; for (int i = 0; i < 3; i += 1) { int x = i; total += x; }";
+
+    // Every initialisation replaces the builtin classes, so each run is checked before the next one starts
+    for (bool tree_walk : { false, true })
+    {
+        EngineRun run = RunEngine(text, tree_walk);
+
+        REQUIRE( !run.error );
+
+        TypeExpression &foo_type = ((DeclareVariable*)run.AST[1])->variable_type;
+        TypeExpression &loop_type = ((DeclareVariable*)((ForLoop*)run.AST[3])->for_code_block->content[0])->variable_type;
+
+        REQUIRE( run.env->Get("total")->value.int_value == 3 );
+        REQUIRE( foo_type.cached_type == run.env->Get("Foo")->value.object );
+        REQUIRE( loop_type.cached_type == IntDefinition );
+        REQUIRE( loop_type.cached_generation == Type_Generation );
+
+        // Defining another class invalidates every cached type
+        Interpret(AnalyseSemantics(get<0>(AnalyseSyntax(Tokenise("class Bar { int v = 1; }")))), run.env, {});
+
+        REQUIRE( loop_type.cached_generation != Type_Generation );
+        REQUIRE( InterpretType(loop_type, run.env).type_definition == IntDefinition );
+        REQUIRE( loop_type.cached_generation == Type_Generation );
+    }
+}
\ No newline at end of file